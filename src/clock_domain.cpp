@@ -0,0 +1,99 @@
+//
+// File: clock_domain.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the clock domain and the workload consumer declared in `clock_domain.h`.
+//
+
+#include "clock_domain.h"
+
+#include <algorithm>
+#include <cmath>
+
+// `sc_time_to_ps()`.
+#include "pll_time.h"
+
+
+
+ClockDomain::ClockDomain(const std::string& name)
+    : domain_name(name), period(0.0), is_locked(false), epoch_ps(0), epoch_cycles(0.0), num_changes(0) {}
+
+
+
+// How it works: The cycles of the interval that ends now are folded into `epoch_cycles` before the period changes, so that everything
+//               before the change keeps the period it was clocked with.
+void ClockDomain::set_clock(double period_ps, bool locked, uint64_t now_ps) {
+    if (period_ps == period && locked == is_locked) {
+        return;
+    }
+    epoch_cycles = cycles_at(now_ps);
+    epoch_ps     = now_ps;
+    period       = period_ps;
+    is_locked    = locked;
+    num_changes++;
+    changed.notify(SC_ZERO_TIME);
+}
+
+
+
+double ClockDomain::cycles_at(uint64_t now_ps) const {
+    if (period <= 0.0 || now_ps <= epoch_ps) {
+        return epoch_cycles;
+    }
+    return epoch_cycles + (now_ps - epoch_ps) / period;
+}
+
+
+
+uint64_t ClockDomain::time_for_cycles(double cycles) const {
+    if (period <= 0.0) {
+        return CLOCK_DOMAIN_NEVER;
+    }
+    return static_cast<uint64_t>(std::ceil(cycles * period));
+}
+
+
+
+clock_workload::clock_workload(sc_module_name name, const ClockDomain& dom, uint64_t cycles_per_job)
+    : sc_module(name), domain(dom), job_cycles(double(cycles_per_job)), remaining(double(cycles_per_job)), mark_ps(0),
+      mark_period(0.0), jobs_done(0), cycles_done(0.0), num_activations(0) {
+
+    // Runs once at time zero to pick up the (stopped) clock; from then on `next_trigger()` alone decides.
+    SC_METHOD(run_process);
+}
+
+
+
+// How it works: An activation first credits the cycles clocked since the previous one, at the period that was in force (the domain
+//               notifies every change, so it cannot have changed in between), then waits for the rest of the current job at the
+//               current period, or for the next change of the domain, whichever comes first. The wait is rounded up to a whole
+//               picosecond, so a job that is due is always complete when the method wakes for it.
+void clock_workload::run_process() {
+
+    num_activations++;
+    uint64_t now_ps = sc_time_to_ps(sc_time_stamp());
+
+    if (mark_period > 0.0) {
+        double clocked = std::min((now_ps - mark_ps) / mark_period, remaining);
+        remaining   -= clocked;
+        cycles_done += clocked;
+        if (remaining <= 1e-9 * job_cycles) {
+            jobs_done++;
+            remaining = job_cycles;
+        }
+    }
+
+    mark_ps     = now_ps;
+    mark_period = domain.period_ps();
+
+    uint64_t wait_ps = domain.time_for_cycles(remaining);
+    if (wait_ps == CLOCK_DOMAIN_NEVER) {
+        next_trigger(domain.changed_event());
+    } else {
+        next_trigger(sc_time(double(wait_ps), SC_PS), domain.changed_event());
+    }
+}
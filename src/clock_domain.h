@@ -0,0 +1,111 @@
+//
+// File: clock_domain.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the clock domain abstraction: the frequency a PLL delivers to the logic it clocks, as an object that downstream
+// models can read and subscribe to, instead of a `cout` line or an output pin that toggles on every edge.
+//
+//   - `ClockDomain`: The clock of one domain. Its source (a `pll`, or PLL `i` of a `pll_bank`) sets its period when it locks, marks it
+//     unlocked (the clock keeps running at the old period while the loop slews) when a relock starts, and stops it (period 0) when it is
+//     disabled or reset. Every change notifies `changed_event()`. The domain keeps the number of cycles elapsed up to its last change, so
+//     a consumer can convert between cycles and time analytically at any moment: `cycles_at(t)` and `time_for_cycles(n)`.
+//   - `clock_workload`: A consumer. It runs jobs of a fixed number of cycles back to back (a CPU executing instruction blocks, a DDR
+//     controller serving bursts) in the time those cycles take at the domain's current frequency. It wakes when a job completes or when
+//     the frequency changes, never on a clock edge: a second of activity at 1 GHz costs a handful of activations, not 10^9.
+//
+
+#ifndef CLOCK_DOMAIN_H
+#define CLOCK_DOMAIN_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+#include <string>
+
+
+
+// What is it: `time_for_cycles()` of a stopped clock: the work never completes.
+#define CLOCK_DOMAIN_NEVER  UINT64_MAX
+
+
+
+class ClockDomain {
+public:
+
+    // What is it: A stopped clock domain.
+    explicit ClockDomain(const std::string& name = "clock_domain");
+
+    // What is it: Called by the source. The clock runs with 'period_ps' (0: stopped) from 'now_ps' on; 'locked' tells consumers whether
+    //             the source is in lock or slewing to a new frequency. A call that changes nothing notifies nothing.
+    void set_clock(double period_ps, bool locked, uint64_t now_ps);
+
+    const std::string& name() const      { return domain_name; }
+    double             period_ps() const { return period; }
+    bool               running() const   { return period > 0.0; }
+    bool               locked() const    { return is_locked; }
+    double             mhz() const       { return period > 0.0 ? 1e6 / period : 0.0; }
+
+    // What is it: The number of cycles the domain has clocked from time zero to 'now_ps' (not before its last change), fractional in
+    //             between two edges.
+    double cycles_at(uint64_t now_ps) const;
+
+    // What is it: The time, in picoseconds, that 'cycles' cycles take at the current period (rounded up to a whole picosecond), or
+    //             `CLOCK_DOMAIN_NEVER` while the clock is stopped.
+    uint64_t time_for_cycles(double cycles) const;
+
+    // What is it: Notified (one delta cycle later) whenever the period or the lock flag changes. Consumers wait on it together with the
+    //             time their current work takes.
+    const sc_event& changed_event() const { return changed; }
+
+    // What is it: The number of changes so far, for the report.
+    uint64_t changes() const { return num_changes; }
+
+private:
+    std::string domain_name;
+    double      period;              // Picoseconds, 0 while stopped
+    bool        is_locked;
+    uint64_t    epoch_ps;            // The time of the last change
+    double      epoch_cycles;        // The cycles clocked up to `epoch_ps`
+    uint64_t    num_changes;
+    sc_event    changed;
+
+    ClockDomain(const ClockDomain&);
+    ClockDomain& operator=(const ClockDomain&);
+};
+
+
+
+SC_MODULE(clock_workload) {
+
+    // What is it: A consumer of 'domain' that runs jobs of 'job_cycles' cycles back to back, from time zero to the end of the simulation.
+    clock_workload(sc_module_name name, const ClockDomain& domain, uint64_t job_cycles);
+
+    SC_HAS_PROCESS(clock_workload);
+
+    // What is it: The result, for the report: completed jobs, cycles executed (including the part of the job in progress at the last
+    //             activation), and the number of activations it took.
+    uint64_t jobs() const        { return jobs_done; }
+    double   cycles() const      { return cycles_done; }
+    uint64_t activations() const { return num_activations; }
+
+private:
+    const ClockDomain& domain;
+    double             job_cycles;
+    double             remaining;    // Cycles left of the current job at `mark_ps`
+    uint64_t           mark_ps;
+    double             mark_period;  // The period from `mark_ps` to now (it has not changed, or the domain would have woken us)
+    uint64_t           jobs_done;
+    double             cycles_done;
+    uint64_t           num_activations;
+
+    void run_process();
+};
+
+
+#endif // CLOCK_DOMAIN_H
@@ -0,0 +1,76 @@
+//
+// File: clock_mux.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the glitch-free clock mux declared in `clock_mux.h`.
+//
+
+#include "clock_mux.h"
+
+#include <cmath>
+
+// `sc_time_to_ps()`.
+#include "pll_time.h"
+
+
+
+clock_mux::clock_mux(sc_module_name name, const ClockDomain& pll_clock, double ref_period_ps, unsigned sync_stages)
+    : sc_module(name), pll(pll_clock), ref_period(ref_period_ps), stages(sync_stages), out(std::string(name) + ".out"),
+      selected(SRC_REF), target(SRC_REF), switching(false), switch_start_ps(0), switch_done_ps(0), num_switches(0), total_gated_ps(0) {
+
+    // Runs once at time zero, to start the output on the reference; from then on `next_trigger()` alone decides.
+    SC_METHOD(mux_process);
+}
+
+
+
+// What is it: Starts a handover from the source the output was last taken from to 'to'. The output stops now and restarts on 'to' when
+//             both synchronisers have been passed. A handover that is still running is abandoned: its old side has already been
+//             disabled, so the new one starts from the source it was switching to.
+void clock_mux::start_switch(Source to, uint64_t now_ps) {
+    Source from = switching ? target : selected;
+    if (switching) {
+        total_gated_ps += now_ps - switch_start_ps;
+    }
+    double latency_ps = stages * (source_period(from) + source_period(to));
+
+    target          = to;
+    switching       = true;
+    switch_start_ps = now_ps;
+    switch_done_ps  = now_ps + static_cast<uint64_t>(std::ceil(latency_ps));
+    out.set_clock(0.0, false, now_ps);
+}
+
+
+
+// How it works: The mux selects the PLL while it is running and in lock, and the reference otherwise. Every activation (a change of the
+//               PLL's domain, or the end of a handover) first completes a handover that is due, then starts one if the wanted source
+//               is not the one selected (or being switched to). While it is on the PLL, the output follows the PLL's domain.
+void clock_mux::mux_process() {
+
+    uint64_t now_ps = sc_time_to_ps(sc_time_stamp());
+
+    if (switching && now_ps >= switch_done_ps) {
+        switching = false;
+        selected  = target;
+        num_switches++;
+        total_gated_ps += now_ps - switch_start_ps;
+    }
+
+    Source wanted = pll.running() && pll.locked() ? SRC_PLL : SRC_REF;
+    if (wanted != (switching ? target : selected)) {
+        start_switch(wanted, now_ps);
+    }
+
+    if (switching) {
+        next_trigger(sc_time(double(switch_done_ps - now_ps), SC_PS), pll.changed_event());
+        return;
+    }
+
+    out.set_clock(source_period(selected), selected == SRC_REF || pll.locked(), now_ps);
+    next_trigger(pll.changed_event());
+}
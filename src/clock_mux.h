@@ -0,0 +1,83 @@
+//
+// File: clock_mux.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `clock_mux`, the glitch-free clock multiplexer between a PLL and the logic it clocks. While the PLL is off or
+// relocking, its consumers would have no clock they can trust. The mux switches them to the reference (bypass) clock instead, and back
+// to the PLL when it reports lock.
+//
+// How the handover is modelled: A glitch-free mux cannot cut from one clock to the other at an arbitrary instant. It first disables the
+// old source, through a synchroniser of `sync_stages` flip-flops clocked by that source, and only then enables the new one, through the
+// same number of stages clocked by the new source. In between, the output is held low. The handover therefore takes
+//
+//     sync_stages x (old source period + new source period)
+//
+// during which the consumer domain is stopped. The mux computes that figure from the two periods when the switch starts, and does not
+// simulate the edges of either clock. A source that is stopped (a PLL that was disabled) has no edges to synchronise on, and its stages
+// are cleared asynchronously: its part of the latency is zero.
+//
+// The mux drives its own `ClockDomain` (`output()`), to which the consumers subscribe in place of the PLL's.
+//
+
+#ifndef CLOCK_MUX_H
+#define CLOCK_MUX_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+
+#include "clock_domain.h"
+
+
+
+// What is it: The number of synchroniser flip-flops per side of the mux, if the top level does not choose one.
+#define CLOCK_MUX_SYNC_STAGES  2
+
+
+
+SC_MODULE(clock_mux) {
+
+    // What is it: A mux between the output of a PLL ('pll_clock') and a reference clock of 'ref_period_ps', with 'sync_stages' flip-flops
+    //             on each side. Out of reset it selects the reference.
+    clock_mux(sc_module_name name, const ClockDomain& pll_clock, double ref_period_ps, unsigned sync_stages = CLOCK_MUX_SYNC_STAGES);
+
+    SC_HAS_PROCESS(clock_mux);
+
+    // What is it: The clock of the consumers: the selected source, and stopped during a handover.
+    ClockDomain& output() { return out; }
+
+    // What is it: The statistics, for the report: the completed handovers, and the time the output was held low by them.
+    uint64_t switches() const     { return num_switches; }
+    uint64_t gated_ps() const     { return total_gated_ps; }
+    bool     on_pll() const       { return selected == SRC_PLL && !switching; }
+
+private:
+    enum Source { SRC_REF, SRC_PLL };
+
+    const ClockDomain& pll;
+    double             ref_period;
+    unsigned           stages;
+    ClockDomain        out;
+
+    Source   selected;           // The source the output runs from (the old one, during a handover)
+    Source   target;             // During a handover: the source being switched to
+    bool     switching;
+    uint64_t switch_start_ps;
+    uint64_t switch_done_ps;
+
+    uint64_t num_switches;
+    uint64_t total_gated_ps;
+
+    double source_period(Source s) const { return s == SRC_PLL ? pll.period_ps() : ref_period; }
+    void   start_switch(Source to, uint64_t now_ps);
+    void   mux_process();
+};
+
+
+#endif // CLOCK_MUX_H
@@ -0,0 +1,277 @@
+//
+// File: dvfs_trace.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the memory-mapped DVFS trace reader declared in `dvfs_trace.h`.
+//
+// A note on parsing: the mapping is NOT null-terminated (the file ends where it ends), so library functions such as `strtod` or `sscanf`
+// cannot be pointed at it safely; they would happily read past the last byte looking for a terminator. The line parser below is
+// therefore hand-written and every read is checked against the end of the current line.
+//
+
+#include "dvfs_trace.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+
+
+// How much consumed data to accumulate before handing it back to the OS. Releasing in large chunks keeps the number of system calls
+// negligible compared with the parsing work, while still capping the resident footprint at a few megabytes.
+static const size_t RELEASE_CHUNK_BYTES = 4u * 1024u * 1024u;
+
+
+
+DvfsTraceReader::DvfsTraceReader()
+    : data(NULL), length(0), pos(0), released(0), line_no(0), malformed(0), out_of_order(0), last_ts(0)
+#ifdef _WIN32
+    , file_handle(NULL), map_handle(NULL)
+#else
+    , fd(-1)
+#endif
+{
+}
+
+
+
+DvfsTraceReader::~DvfsTraceReader() {
+    close();
+}
+
+
+
+bool DvfsTraceReader::open(const std::string& trace_path) {
+
+    close();
+    path = trace_path;
+
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (fh == INVALID_HANDLE_VALUE) {
+        std::cerr << "DVFS_TRACE: Cannot open '" << path << "'." << std::endl;
+        return false;
+    }
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(fh, &sz)) {
+        std::cerr << "DVFS_TRACE: Cannot get the size of '" << path << "'." << std::endl;
+        CloseHandle(fh);
+        return false;
+    }
+    file_handle = fh;
+    length      = static_cast<size_t>(sz.QuadPart);
+    if (length == 0) {
+        return true;
+    }
+    HANDLE mh = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mh == NULL) {
+        std::cerr << "DVFS_TRACE: Cannot map '" << path << "'." << std::endl;
+        close();
+        return false;
+    }
+    map_handle = mh;
+    data = static_cast<const char*>(MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0));
+    if (data == NULL) {
+        std::cerr << "DVFS_TRACE: Cannot map '" << path << "'." << std::endl;
+        close();
+        return false;
+    }
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "DVFS_TRACE: Cannot open '" << path << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::cerr << "DVFS_TRACE: Cannot stat '" << path << "': " << std::strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length == 0) {
+        return true;    // mmap() rejects a zero length; an empty trace simply has no requests.
+    }
+    void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "DVFS_TRACE: Cannot map '" << path << "': " << std::strerror(errno) << std::endl;
+        length = 0;
+        close();
+        return false;
+    }
+    data = static_cast<const char*>(p);
+
+    // We read strictly front to back: let the kernel read ahead aggressively and drop pages behind us early.
+    madvise(p, length, MADV_SEQUENTIAL);
+#endif
+
+    return true;
+}
+
+
+
+void DvfsTraceReader::close() {
+#ifdef _WIN32
+    if (data != NULL)        UnmapViewOfFile(data);
+    if (map_handle != NULL)  CloseHandle(static_cast<HANDLE>(map_handle));
+    if (file_handle != NULL) CloseHandle(static_cast<HANDLE>(file_handle));
+    map_handle  = NULL;
+    file_handle = NULL;
+#else
+    if (data != NULL) munmap(const_cast<char*>(data), length);
+    if (fd >= 0)      ::close(fd);
+    fd = -1;
+#endif
+    data      = NULL;
+    length    = 0;
+    pos       = 0;
+    released  = 0;
+    line_no      = 0;
+    malformed    = 0;
+    out_of_order = 0;
+    last_ts      = 0;
+}
+
+
+
+// What is it: Hands the pages in front of the parse position back to the OS.
+// How it works: On POSIX, `MADV_DONTNEED` drops the pages from our resident set; because the mapping is a read-only view of a file they
+//               would simply be re-read from the page cache if ever touched again (they never are). Windows has no direct equivalent
+//               for a file view; there the working set is trimmed by the OS and `FILE_FLAG_SEQUENTIAL_SCAN` hints at the access pattern.
+void DvfsTraceReader::release_consumed_pages() {
+#ifndef _WIN32
+    if (pos - released < RELEASE_CHUNK_BYTES) {
+        return;
+    }
+    size_t page  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t upto  = (pos / page) * page;
+    if (upto > released) {
+        madvise(const_cast<char*>(data) + released, upto - released, MADV_DONTNEED);
+        released = upto;
+    }
+#endif
+}
+
+
+
+// Small helpers for the bounds-checked parser. All of them take the current position 'p' by reference and never move it past 'end'.
+// A number too large for its type is a parse failure, not a silently wrapped value.
+static void skip_blanks(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+}
+
+static bool parse_u64(const char*& p, const char* end, uint64_t& out) {
+    const char* start = p;
+    uint64_t v = 0;
+    bool overflow = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        uint64_t digit = static_cast<uint64_t>(*p - '0');
+        if (v > (UINT64_MAX - digit) / 10u) {
+            overflow = true;
+        }
+        v = v * 10u + digit;
+        ++p;
+    }
+    out = v;
+    return p != start && !overflow;
+}
+
+static bool parse_decimal(const char*& p, const char* end, double& out) {
+    bool any = false;
+    double v = 0.0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10.0 + (*p - '0');
+        ++p;
+        any = true;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v += (*p - '0') * scale;
+            scale *= 0.1;
+            ++p;
+            any = true;
+        }
+    }
+    out = v;
+    return any;
+}
+
+
+
+bool DvfsTraceReader::next(DvfsRequest& req) {
+
+    while (data != NULL && pos < length) {
+
+        const char* line = data + pos;
+        const char* end  = data + length;
+        const char* eol  = line;
+        while (eol < end && *eol != '\n') ++eol;
+
+        // Advance past this line (and its newline, if there is one) before looking at it, so every `continue` below makes progress.
+        pos = static_cast<size_t>(eol - data) + (eol < end ? 1 : 0);
+        ++line_no;
+        release_consumed_pages();
+
+        const char* p = line;
+        skip_blanks(p, eol);
+        if (p == eol || *p == '#') {
+            continue;
+        }
+
+        uint64_t ts;
+        double   mhz;
+        bool ok = parse_u64(p, eol, ts);
+        skip_blanks(p, eol);
+        ok = ok && p < eol && *p == ',';
+        if (ok) {
+            ++p;
+            skip_blanks(p, eol);
+            ok = parse_decimal(p, eol, mhz);
+            skip_blanks(p, eol);
+            ok = ok && p == eol;
+        }
+
+        if (!ok) {
+            if (malformed == out_of_order) {    // The first line that does not parse (out-of-order lines have their own message).
+                std::cerr << "DVFS_TRACE: " << path << ":" << line_no << ": malformed line skipped "
+                          << "(expected '<timestamp_ns>,<target_mhz>')." << std::endl;
+            }
+            ++malformed;
+            continue;
+        }
+
+        // Timestamps must be non-decreasing. A request that goes back in time cannot be replayed in order, so it is rejected like a
+        // malformed line; the requests after it are still compared against the last accepted timestamp.
+        if (ts < last_ts) {
+            if (out_of_order == 0) {
+                std::cerr << "DVFS_TRACE: " << path << ":" << line_no << ": timestamp " << ts << " ns is before the previous request ("
+                          << last_ts << " ns); line skipped." << std::endl;
+            }
+            ++out_of_order;
+            ++malformed;
+            continue;
+        }
+        last_ts = ts;
+
+        req.timestamp_ns = ts;
+        req.target_mhz   = mhz;
+        return true;
+    }
+
+    return false;
+}
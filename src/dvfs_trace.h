@@ -0,0 +1,102 @@
+//
+// File: dvfs_trace.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares a reader for recorded DVFS governor traces. A trace is the log of frequency requests that an OS governor
+// (e.g. Linux `schedutil`) made over a real workload: one request per line, in the form
+//
+//     <timestamp_ns>,<target_mhz>
+//
+// Blank lines and lines beginning with `#` are ignored. Timestamps must be non-decreasing; a line whose timestamp is earlier than the
+// previous request's is reported with its line number and skipped like a malformed line.
+//
+// Traces from a long workload easily reach millions of lines, so the reader is built around two rules:
+//   1. The file is memory-mapped, never copied. Parsing walks the mapping directly and produces one request at a time.
+//   2. Memory use stays bounded. The mapping is read strictly front to back, and pages that have already been consumed are handed back
+//      to the OS as the reader moves on, so the resident footprint does not grow with the length of the trace.
+//
+
+#ifndef DVFS_TRACE_H
+#define DVFS_TRACE_H
+
+
+
+// `uint64_t` for timestamps and `size_t` for offsets into the mapping.
+#include <cstdint>
+#include <cstddef>
+
+// `std::string` for the file path used in error messages.
+#include <string>
+
+
+
+// What is it: One frequency request from the governor trace.
+struct DvfsRequest {
+    uint64_t timestamp_ns;  // When the governor asked, relative to the start of the trace.
+    double   target_mhz;    // What it asked for.
+};
+
+
+
+//================================================================================================================================
+// C++ Concept: RAII (Resource Acquisition Is Initialization)
+//================================================================================================================================
+// What is it: `DvfsTraceReader` owns an operating-system resource (a file mapping). The destructor calls `close()`, so the mapping is
+//             always released, no matter how the owning scope is left.
+// Why is it used: The testbench opens a trace at the start of a scenario and may stop early (e.g. on a failed lock). RAII means none of
+//               those exit paths needs its own clean-up code. Copying is disabled, because two readers sharing one mapping would
+//               unmap it twice.
+
+class DvfsTraceReader {
+public:
+    DvfsTraceReader();
+    ~DvfsTraceReader();
+
+    // What is it: Maps the trace file read-only.
+    // Returns: `false` (and prints the reason) if the file cannot be opened or mapped. An empty file opens successfully and simply has
+    //          no requests.
+    bool open(const std::string& path);
+
+    // What is it: Parses the next request.
+    // Returns: `true` and fills in 'req' if a request was read, `false` at the end of the trace. Malformed lines are counted in
+    //          `malformed_lines()` and skipped, so one bad line does not abort a long replay. Out-of-order timestamps count as malformed
+    //          and are also counted separately in `out_of_order_lines()`.
+    bool next(DvfsRequest& req);
+
+    // What is it: Unmaps the file. Safe to call more than once.
+    void close();
+
+    unsigned long malformed_lines()    const { return malformed; }
+    unsigned long out_of_order_lines() const { return out_of_order; }
+    size_t        size_bytes()         const { return length; }
+
+private:
+    DvfsTraceReader(const DvfsTraceReader&);             // Not copyable (see above).
+    DvfsTraceReader& operator=(const DvfsTraceReader&);
+
+    void release_consumed_pages();
+
+    std::string   path;
+    const char*   data;       // Start of the mapping (NULL when closed or when the file is empty).
+    size_t        length;     // Size of the mapping in bytes.
+    size_t        pos;        // Parse position. Everything before it has been consumed.
+    size_t        released;   // Everything before this offset has already been handed back to the OS.
+    unsigned long line_no;
+    unsigned long malformed;
+    unsigned long out_of_order;
+    uint64_t      last_ts;    // Timestamp of the last request returned by `next()`.
+
+#ifdef _WIN32
+    void* file_handle;
+    void* map_handle;
+#else
+    int   fd;
+#endif
+};
+
+
+#endif // DVFS_TRACE_H
@@ -0,0 +1,228 @@
+//
+// File: latency_histogram.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the log-bucketed latency histogram declared in `latency_histogram.h`, and its save / load (merge) file format.
+//
+
+#include "latency_histogram.h"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+
+
+LatencyHistogram::LatencyHistogram(const std::string& name, const std::string& unit)
+    : hist_name(name), hist_unit(unit), counts(BUCKET_COUNT, 0), total(0), sum(0), min_value(0), max_value(0) {
+}
+
+
+
+void LatencyHistogram::reset() {
+    counts.assign(BUCKET_COUNT, 0);
+    total = sum = min_value = max_value = 0;
+}
+
+
+
+// What is it: Position of the most significant set bit of a non-zero value, found by a fixed six-step binary search so that the cost of
+//             `record()` does not depend on the value (and without relying on compiler intrinsics).
+static unsigned msb_position(uint64_t v) {
+    unsigned pos = 0;
+    if (v >> 32) { v >>= 32; pos += 32; }
+    if (v >> 16) { v >>= 16; pos += 16; }
+    if (v >> 8)  { v >>= 8;  pos += 8;  }
+    if (v >> 4)  { v >>= 4;  pos += 4;  }
+    if (v >> 2)  { v >>= 2;  pos += 2;  }
+    if (v >> 1)  {           pos += 1;  }
+    return pos;
+}
+
+
+
+// What is it: Maps a value to its bucket.
+// How it works: Values below 128 index directly. For larger values, 'shift' is how far the value must be shifted right to keep its top
+//               7 bits; those 7 bits (64 .. 127) select the sub-bucket, and 'shift' selects the power-of-two range.
+unsigned LatencyHistogram::index_of(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<unsigned>(value);
+    }
+    unsigned shift = msb_position(value) - (SUB_BUCKET_BITS - 1);
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + static_cast<unsigned>((value >> shift) - SUB_BUCKET_HALF);
+}
+
+uint64_t LatencyHistogram::lowest_of(unsigned index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    unsigned k     = index - SUB_BUCKET_COUNT;
+    unsigned shift = k / SUB_BUCKET_HALF + 1;
+    return static_cast<uint64_t>(k % SUB_BUCKET_HALF + SUB_BUCKET_HALF) << shift;
+}
+
+uint64_t LatencyHistogram::highest_of(unsigned index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    unsigned shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+    return lowest_of(index) + ((static_cast<uint64_t>(1) << shift) - 1);
+}
+
+
+
+void LatencyHistogram::record(uint64_t value) {
+    counts[index_of(value)]++;
+    if (total == 0 || value < min_value) min_value = value;
+    if (value > max_value)               max_value = value;
+    total++;
+    sum += value;
+}
+
+
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) {
+        return;
+    }
+    for (unsigned i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] += other.counts[i];
+    }
+    if (total == 0 || other.min_value < min_value) min_value = other.min_value;
+    if (other.max_value > max_value)               max_value = other.max_value;
+    total += other.total;
+    sum   += other.sum;
+}
+
+
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (total == 0) {
+        return 0;
+    }
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+
+    // The rank of the requested sample, 1-based, rounded up so that e.g. p99 of 100 samples is the 99th sample.
+    uint64_t rank = static_cast<uint64_t>(q * total);
+    if (static_cast<double>(rank) < q * total) rank++;
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t v = highest_of(i);
+            return v < max_value ? v : max_value;
+        }
+    }
+    return max_value;
+}
+
+
+
+void LatencyHistogram::print(std::ostream& os) const {
+    os << hist_name << ": ";
+    if (total == 0) {
+        os << "no samples" << std::endl;
+        return;
+    }
+    os << "n=" << total
+       << " min=" << min() << " mean=" << static_cast<uint64_t>(mean() + 0.5)
+       << " p50=" << percentile(0.50) << " p90=" << percentile(0.90)
+       << " p99=" << percentile(0.99) << " p99.9=" << percentile(0.999)
+       << " max=" << max() << " " << hist_unit << std::endl;
+}
+
+
+
+//================================================================================================================================
+// Save / Load
+//================================================================================================================================
+// The file format is plain text so that results from different machines and compilers merge without any endianness concerns:
+//
+//     latency_histogram v1 <name> <count> <sum> <min> <max>
+//     <bucket> <count>
+//     ...
+//     end
+//
+// Only non-empty buckets are written, so a typical file is a few dozen lines.
+
+bool save_histograms(const std::string& path, const std::vector<const LatencyHistogram*>& hists) {
+
+    std::ofstream out(path.c_str());
+    if (!out) {
+        std::cerr << "HISTOGRAM: Cannot write '" << path << "'." << std::endl;
+        return false;
+    }
+
+    for (unsigned h = 0; h < hists.size(); ++h) {
+        const LatencyHistogram& hist = *hists[h];
+        out << "latency_histogram v1 " << hist.hist_name << " " << hist.total << " " << hist.sum << " "
+            << hist.min_value << " " << hist.max_value << "\n";
+        for (unsigned i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+            if (hist.counts[i] != 0) {
+                out << i << " " << hist.counts[i] << "\n";
+            }
+        }
+        out << "end\n";
+    }
+
+    return static_cast<bool>(out);
+}
+
+
+
+bool load_histograms(const std::string& path, std::vector<LatencyHistogram*>& hists) {
+
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "HISTOGRAM: Cannot read '" << path << "'." << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::istringstream header(line);
+        std::string magic, version, name;
+        LatencyHistogram section("");
+        header >> magic >> version >> name >> section.total >> section.sum >> section.min_value >> section.max_value;
+        if (!header || magic != "latency_histogram" || version != "v1") {
+            std::cerr << "HISTOGRAM: '" << path << "' is not a latency histogram file." << std::endl;
+            return false;
+        }
+
+        while (std::getline(in, line) && line != "end") {
+            std::istringstream bucket(line);
+            unsigned i;
+            uint64_t c;
+            if (!(bucket >> i >> c) || i >= LatencyHistogram::BUCKET_COUNT) {
+                std::cerr << "HISTOGRAM: '" << path << "': bad bucket line '" << line << "'." << std::endl;
+                return false;
+            }
+            section.counts[i] = c;
+        }
+
+        LatencyHistogram* target = NULL;
+        for (unsigned h = 0; h < hists.size() && target == NULL; ++h) {
+            if (hists[h]->name() == name) {
+                target = hists[h];
+            }
+        }
+        if (target == NULL) {
+            target = new LatencyHistogram(name);
+            hists.push_back(target);
+        }
+        target->merge(section);
+    }
+
+    return true;
+}
@@ -0,0 +1,94 @@
+//
+// File: latency_histogram.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `LatencyHistogram`, a fixed-memory, log-bucketed latency histogram in the style of HdrHistogram. The testbench
+// uses it to record every lock time, relock time and bus transaction latency of a run, so a run reports a latency *distribution*
+// (p50, p90, p99, p99.9, max) rather than a single SUCCESS / FAILED line.
+//
+// Design:
+//   - Values are non-negative integers (the testbench records nanoseconds).
+//   - Values below 128 get one bucket each, so they are recorded exactly. Above that, every power-of-two range [2^k, 2^(k+1)) is split
+//     into 64 equal sub-buckets, so any recorded value is known to within 1/64 (about 1.6 %) of itself, over the whole 64-bit range.
+//   - The bucket array has a fixed size (3776 counters, ~30 KB), whatever the number of samples or their spread. Recording is O(1).
+//   - Two histograms of the same layout merge by adding their counters. This is what makes the results of parallel sweep workers
+//     (separate processes, e.g. one per configuration) combinable: each worker saves its histograms with `save_histograms()`, and
+//     `load_histograms()` adds a saved file into the in-memory ones.
+//
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+
+
+
+class LatencyHistogram {
+public:
+
+    // What is it: The layout constants described in the file header.
+    static const unsigned SUB_BUCKET_BITS  = 7;                              // 128 linear buckets for the smallest values
+    static const unsigned SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;          // 128
+    static const unsigned SUB_BUCKET_HALF  = SUB_BUCKET_COUNT / 2;           // 64 sub-buckets per power of two above that
+    static const unsigned BUCKET_COUNT     = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+    // 'name' identifies the histogram in reports and in saved files; 'unit' is only used for printing.
+    explicit LatencyHistogram(const std::string& name, const std::string& unit = "ns");
+
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    const std::string& name()  const { return hist_name; }
+    uint64_t           count() const { return total; }
+    uint64_t           min()   const { return total ? min_value : 0; }
+    uint64_t           max()   const { return max_value; }
+    double             mean()  const { return total ? static_cast<double>(sum) / total : 0.0; }
+
+    // What is it: The value at quantile 'q' (0.0 .. 1.0).
+    // Returns: The highest value that falls into the same bucket as the sample of that rank, i.e. a conservative (never optimistic)
+    //          estimate, capped at the exact recorded maximum. 0 if the histogram is empty.
+    uint64_t percentile(double q) const;
+
+    // What is it: Prints a one-line summary: count, min, mean, p50, p90, p99, p99.9 and max.
+    void print(std::ostream& os) const;
+
+private:
+    static unsigned index_of(uint64_t value);
+    static uint64_t lowest_of(unsigned index);
+    static uint64_t highest_of(unsigned index);
+
+    friend bool save_histograms(const std::string&, const std::vector<const LatencyHistogram*>&);
+    friend bool load_histograms(const std::string&, std::vector<LatencyHistogram*>&);
+
+    std::string           hist_name;
+    std::string           hist_unit;
+    std::vector<uint64_t> counts;      // Sized once in the constructor, never grows.
+    uint64_t              total;
+    uint64_t              sum;
+    uint64_t              min_value;
+    uint64_t              max_value;
+};
+
+
+
+// What is it: Writes a set of histograms to a small text file: a header line per histogram, then one "<bucket> <count>" line per
+//             non-empty bucket. Returns `false` if the file cannot be written.
+bool save_histograms(const std::string& path, const std::vector<const LatencyHistogram*>& hists);
+
+// What is it: Reads a file written by `save_histograms()` and merges every section into the histogram of the same name. A section with
+//             no matching histogram is added to 'hists' as a new histogram allocated with `new`; the caller owns it. Returns `false`
+//             if the file cannot be read or is not a histogram file.
+bool load_histograms(const std::string& path, std::vector<LatencyHistogram*>& hists);
+
+
+#endif // LATENCY_HISTOGRAM_H
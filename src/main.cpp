@@ -64,6 +64,75 @@
 #include "pmu_tb.h"
 
 
+// What is it: The functional coverage collector that the top level attaches to every PLL.
+#include "pll_coverage.h"
+
+
+// What is it: The scoreboard that checks every lock against a golden reference model, on its own worker thread.
+#include "pll_scoreboard.h"
+
+// `sc_time_to_ps()`.
+#include "pll_time.h"
+
+
+// What is it: The Monte Carlo engine for process variation of the lock time.
+#include "pll_monte_carlo.h"
+
+
+// What is it: The period-jitter source of the PLL output clocks.
+#include "pll_jitter.h"
+
+
+// What is it: The per-state power table and the energy meter of each PLL.
+#include "pll_power.h"
+
+
+// What is it: The columnar results file, one record per PLL per run.
+#include "pll_results.h"
+
+
+// What is it: The structure-of-arrays model of many PLLs in one module, and its differential check against `pll`.
+#include "pll_bank.h"
+
+
+// What is it: The netlist reader and the topology builder that constructs and binds the PLLs and their signals in bulk.
+#include "pll_topology.h"
+
+// What is it: The clock domain every PLL can feed, and the workload model that consumes cycles of a domain without per-cycle events.
+#include "clock_domain.h"
+
+// What is it: The glitch-free mux that moves a clock domain to the reference clock while its PLL is off or relocking.
+#include "clock_mux.h"
+
+// What is it: The reset controller that drives one reset net per reset domain of the netlist, from the PMU's system reset.
+#include "pll_reset.h"
+
+// What is it: The sigma-delta modulator of the fractional-N mode, and the instantaneous frequency and spurs of a fractional-N clock.
+#include "pll_sigma_delta.h"
+
+// What is it: The lock timer shared by all PLL instances, which holds their lock deadlines in one timer wheel.
+#include "pll_lock_timer.h"
+
+
+
+
+// Standard C++ library headers used by the top level: `std::vector` holds the PLL instances, `std::string` builds their names and
+// parses the command line, `<cstdlib>` provides `std::atoi` / `std::strtoull` for converting numeric arguments, and `<chrono>` times
+// the simulation and the stimulus and jitter benchmarks, `<cmath>` compares the Monte Carlo spot-check lock times, and `<random>`
+// provides the per-edge baseline of the jitter benchmark. `<algorithm>` finds the longest reset release delay. `getrusage()` gives the
+// peak memory for --resources.
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+
 
 
 
@@ -72,12 +141,384 @@
 // Parameters:
 //   - 'argc' (argument count): An integer that holds the number of command-line arguments passed to the program when it was run.
 //   - 'argv' (argument vector): An array of C-style strings, where each string is one of the command-line arguments.
-// Purpose: While we are not using command-line arguments in this project, it's standard practice to include them. They could be used in the future
-//          to make the simulation more flexible, for example, to pass in a target frequency instead of having it hard-coded.
+// Purpose: The command-line arguments make the simulation more flexible without recompiling. Supported options:
+//            --plls <n>   Number of PLL instances sharing the bus (default 1). PLL `i` decodes the window at `PLL_BASE_ADDR(i)`.
+//            --netlist <f>  Build the system from netlist file <f> (see `pll_topology.h`): named groups of PLLs, their register windows,
+//                         their reset domains and the clock period. The netlist's size replaces --plls.
+//            --dfs <n>    After the initial lock, stream <n> DFS frequency steps at PLL 0 and report the relock latencies.
+//            --trace <f>  After the initial lock, replay the DVFS governor trace in file <f> on PLL 0 (see `dvfs_trace.h`).
+//            --quiet      Suppress the per-transaction log lines of the PLL and the PMU, and the "constructed" line of every module
+//                         instance; summaries are still printed.
+//            --hist-out <f>    Save the run's latency histograms to file <f> at the end of the run.
+//            --hist-merge <f>  Do not simulate; merge histogram file <f> (repeatable) into one report. Used to combine the results of
+//                              parallel sweep workers; with --hist-out the merged result is saved as well.
+//            --cov-out <f>     Save the run's functional coverage database to file <f>.
+//            --cov-merge <f>   Do not simulate; merge coverage database <f> (repeatable) and report it. With --cov-out the merged
+//                              database is saved as well.
+//            --random <n>      After the initial lock, run <n> constrained-random programming sequences (see `pll_stimulus.h`).
+//            --agents <n>      After the initial lock, run one power-management agent per PLL, all concurrently, each issuing <n> DFS
+//                              steps at its PLL. The agents are coroutines sharing the PMU's one thread (see `pmu_coro.h`).
+//            --reset-mid-lock  After the initial lock, start a relock on every PLL, assert the system reset in the middle of it, and
+//                              check that every PLL comes out of the reset switched off.
+//            --domain-reset <name>  After the initial lock, reset the netlist's reset domain <name> alone, relock its PLLs, and check
+//                              that no PLL of another domain was woken.
+//            --seed <s>        Seed of the random programs (default 1).
+//            --random-start <i>  Index of the first random program (default 0); with --random 1, reruns exactly program <i>.
+//            --stim-bench <n>  Do not simulate; time the generation of <n> random programs and report the rate.
+//            --mc <n>          Do not simulate; evaluate the lock-time model for <n> process-variation dies (seed from --seed) at each
+//                              target frequency and report the lock-time and frequency-error distributions (see `pll_monte_carlo.h`).
+//            --mc-target <f>   Target output frequency in MHz for --mc (repeatable; default 400, 800, 1200 and 1600 MHz).
+//            --mc-spot <k>     With --mc, then simulate dies 0 .. k-1 as k PLLs and check every simulated lock time against the batch
+//                              result.
+//            --clk-out         Generate the `clk_out` clock of every PLL (off by default: it is by far the busiest signal) and trace
+//                              PLL 0's in the waveform.
+//            --jitter <ps>     Random period jitter of the output clocks, RMS in ps (see `pll_jitter.h`). Implies --clk-out.
+//            --spur <a>@<f>    A deterministic spur of peak <a> ps at <f> MHz (repeatable, up to 4). Implies --clk-out.
+//            --jitter-bench <n>  Do not simulate; time <n> jitter samples from the buffered source against per-edge
+//                              `std::normal_distribution` and report the cost per edge.
+//            --power <f>       Estimate every PLL's energy from its time in each state and its bus writes, with the power table in
+//                              file <f> ("default" for the built-in table, see `pll_power.h`), and report it at the end of the run.
+//            --results-out <f> Append one record per PLL (configuration, frequencies, lock time, wall time, pass / fail) to the
+//                              columnar results file <f> (see `pll_results.h`). Parallel workers may share one file.
+//            --run-id <n>      Run id stored in those records (default 0), to tell the runs of a sweep apart.
+//            --results-dump <f>  Do not simulate; print results file <f> as CSV.
+//            --bank            Model the PLLs as one `pll_bank` (see `pll_bank.h`) instead of <n> `pll` modules. For systems with
+//                              thousands of PLLs; without the `clk_out` pins.
+//            --bank-check      Simulate a `pll_bank` next to the <n> `pll` modules, on the same bus, and check that both drive the same
+//                              `locked` and `irq` levels at every delta cycle and end with the same registers.
+//            --workload <c>    Give every PLL a clock domain and attach a workload to each that runs jobs of <c> cycles back to back at
+//                              the domain's current frequency (see `clock_domain.h`), and report the work done at the end of the run.
+//            --clock-mux <s>   With --workload, clock every workload through a glitch-free mux with <s> synchroniser stages per side
+//                              (see `clock_mux.h`), which runs it from the reference clock while its PLL is off or relocking.
+//            --frac <f>        Program FRAC = <f> (in 2^-24 units of M, see `PLL_REG_FRAC_ADDR`) with the solved dividers, which
+//                              makes the PLLs fractional-N, and report PLL 0's instantaneous frequency and spurs at the end of the run.
+//            --resources       At the end of the run, report the wall time of building the model and of simulating it, the peak
+//                              memory of the process, how much of the build was the topology builder, and the number of thread and
+//                              method processes (used by `make scale-bench`).
+
+
+// What is it: Counts the thread and method processes in the object tree below 'objs', for --resources. A thread owns a coroutine stack,
+//             a method does not, so the number of threads per PLL is what decides the memory of a large system.
+static void count_processes(const std::vector<sc_object*>& objs, uint64_t& threads, uint64_t& methods) {
+    for (unsigned i = 0; i < objs.size(); ++i) {
+        std::string kind = objs[i]->kind();
+        if (kind == "sc_thread_process" || kind == "sc_cthread_process") {
+            threads++;
+        } else if (kind == "sc_method_process") {
+            methods++;
+        }
+        count_processes(objs[i]->get_child_objects(), threads, methods);
+    }
+}
+
 
 
 int sc_main(int argc, char* argv[]) {
 
+
+    // What is it: A minimal command-line parser. `std::atoi` converts the text after the option into an integer. Anything not recognised is reported and ignored rather than silently changing behavior.
+    int num_plls  = 1;
+    int dfs_steps = 0;
+    int agent_steps = 0;
+    std::string trace_path;
+    std::string netlist_path;
+    std::string hist_out;
+    std::vector<std::string> hist_merge;
+    std::string cov_out;
+    std::vector<std::string> cov_merge;
+    uint64_t random_count = 0, random_seed = 1, random_start = 0, stim_bench = 0;
+    uint64_t mc_samples = 0;
+    std::vector<double> mc_targets;
+    int mc_spot = 0;
+    bool clk_out = false;
+    PllJitterConfig jitter_cfg = { 0.0, 0, {} };
+    uint64_t jitter_bench = 0;
+    std::string power_path;
+    uint64_t workload_cycles = 0;
+    int mux_stages = 0;
+    uint32_t frac = 0;
+    std::string results_out, results_dump;
+    uint64_t run_id = 0;
+    bool resources = false;
+    bool use_bank = false, bank_check = false;
+    bool reset_mid_lock = false;
+    std::string domain_reset;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--plls" && i + 1 < argc) {
+            num_plls = std::atoi(argv[++i]);
+        } else if (arg == "--netlist" && i + 1 < argc) {
+            netlist_path = argv[++i];
+        } else if (arg == "--dfs" && i + 1 < argc) {
+            dfs_steps = std::atoi(argv[++i]);
+        } else if (arg == "--agents" && i + 1 < argc) {
+            agent_steps = std::atoi(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (arg == "--hist-out" && i + 1 < argc) {
+            hist_out = argv[++i];
+        } else if (arg == "--hist-merge" && i + 1 < argc) {
+            hist_merge.push_back(argv[++i]);
+        } else if (arg == "--cov-out" && i + 1 < argc) {
+            cov_out = argv[++i];
+        } else if (arg == "--cov-merge" && i + 1 < argc) {
+            cov_merge.push_back(argv[++i]);
+        } else if (arg == "--random" && i + 1 < argc) {
+            random_count = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            random_seed = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--random-start" && i + 1 < argc) {
+            random_start = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--stim-bench" && i + 1 < argc) {
+            stim_bench = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--mc" && i + 1 < argc) {
+            mc_samples = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--mc-target" && i + 1 < argc) {
+            mc_targets.push_back(std::atof(argv[++i]));
+        } else if (arg == "--mc-spot" && i + 1 < argc) {
+            mc_spot = std::atoi(argv[++i]);
+        } else if (arg == "--clk-out") {
+            clk_out = true;
+        } else if (arg == "--jitter" && i + 1 < argc) {
+            jitter_cfg.rj_rms_ps = std::atof(argv[++i]);
+            clk_out = true;
+        } else if (arg == "--spur" && i + 1 < argc) {
+            char* at = NULL;
+            PllSpur spur;
+            spur.amp_ps   = std::strtod(argv[++i], &at);
+            spur.freq_mhz = (*at == '@') ? std::strtod(at + 1, NULL) : 0.0;
+            if (*at != '@' || jitter_cfg.num_spurs == PLL_JITTER_MAX_SPURS) {
+                cout << "Ignoring spur '" << argv[i] << "' (expected <ps>@<MHz>, at most " << PLL_JITTER_MAX_SPURS << ")" << endl;
+            } else {
+                jitter_cfg.spurs[jitter_cfg.num_spurs++] = spur;
+                clk_out = true;
+            }
+        } else if (arg == "--power" && i + 1 < argc) {
+            power_path = argv[++i];
+        } else if (arg == "--workload" && i + 1 < argc) {
+            workload_cycles = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--clock-mux" && i + 1 < argc) {
+            mux_stages = std::atoi(argv[++i]);
+        } else if (arg == "--frac" && i + 1 < argc) {
+            frac = uint32_t(std::strtoull(argv[++i], NULL, 0) & (PLL_FRAC_ONE - 1));
+        } else if (arg == "--results-out" && i + 1 < argc) {
+            results_out = argv[++i];
+        } else if (arg == "--results-dump" && i + 1 < argc) {
+            results_dump = argv[++i];
+        } else if (arg == "--run-id" && i + 1 < argc) {
+            run_id = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--reset-mid-lock") {
+            reset_mid_lock = true;
+        } else if (arg == "--domain-reset" && i + 1 < argc) {
+            domain_reset = argv[++i];
+        } else if (arg == "--bank") {
+            use_bank = true;
+        } else if (arg == "--bank-check") {
+            bank_check = true;
+        } else if (arg == "--resources") {
+            resources = true;
+        } else if (arg == "--jitter-bench" && i + 1 < argc) {
+            jitter_bench = std::strtoull(argv[++i], NULL, 0);
+        } else if (arg == "--quiet") {
+            // Set here, while parsing, so it is in force before any module is constructed (their constructors print unless quiet).
+            pll::verbose    = false;
+            pmu_tb::verbose = false;
+        } else {
+            cout << "Ignoring unknown argument: " << arg << endl;
+        }
+    }
+    if (num_plls < 1) {
+        num_plls = 1;
+    }
+    if (mux_stages > 0 && workload_cycles == 0) {
+        cout << "The clock muxes feed the workloads: ignoring --clock-mux without --workload." << endl;
+        mux_stages = 0;
+    }
+    if (use_bank && (clk_out || bank_check)) {
+        cout << "The PLL bank has no clk_out pins and is not checked against itself: ignoring --clk-out, --jitter, --spur and --bank-check."
+             << endl;
+        clk_out    = false;
+        bank_check = false;
+    }
+
+
+    // What is it: The histogram merge mode. No modules are created and no simulation runs: the saved histograms of several earlier runs
+    //             are added together, by name, and reported as one distribution.
+    if (!hist_merge.empty()) {
+        std::vector<LatencyHistogram*> merged;
+        bool ok = true;
+        for (unsigned i = 0; i < hist_merge.size(); ++i) {
+            ok = load_histograms(hist_merge[i], merged) && ok;
+        }
+        cout << "Merged " << hist_merge.size() << " histogram file(s):" << endl;
+        for (unsigned i = 0; i < merged.size(); ++i) {
+            cout << "  ";
+            merged[i]->print(cout);
+        }
+        if (!hist_out.empty()) {
+            std::vector<const LatencyHistogram*> out(merged.begin(), merged.end());
+            ok = save_histograms(hist_out, out) && ok;
+        }
+        for (unsigned i = 0; i < merged.size(); ++i) {
+            delete merged[i];
+        }
+        return ok ? 0 : 1;
+    }
+
+
+    // What is it: The coverage merge mode, the counterpart of the histogram merge mode for functional coverage databases.
+    if (!cov_merge.empty()) {
+        PllCoverage merged;
+        bool ok = true;
+        for (unsigned i = 0; i < cov_merge.size(); ++i) {
+            ok = merged.load(cov_merge[i]) && ok;
+        }
+        cout << "Merged " << cov_merge.size() << " coverage database(s):" << endl;
+        merged.report(cout);
+        if (!cov_out.empty()) {
+            ok = merged.save(cov_out) && ok;
+        }
+        return ok ? 0 : 1;
+    }
+
+
+    // What is it: The results dump mode: the records of a results file as CSV on stdout, for any analysis tool; the row count goes to
+    //             stderr so that the output stays a clean table.
+    if (!results_dump.empty()) {
+        PllResultsTable table;
+        bool ok = load_results(results_dump, table);
+        table.print_csv(cout);
+        std::cerr << "RESULTS: " << table.rows() << " records." << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    // What is it: The stimulus benchmark mode. It generates random programs as fast as it can, with nothing else running, to check that
+    //             stimulus generation can never be what limits a sweep.
+    if (stim_bench > 0) {
+        StimulusGenerator gen(random_seed);
+        StimulusProgram   prog;
+        uint64_t          writes = 0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (uint64_t k = 0; k < stim_bench; ++k) {
+            gen.generate(k, prog);
+            writes += prog.num_ops;
+        }
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        cout << "Generated " << stim_bench << " programs (" << writes << " operations) in " << s << " s: "
+             << (s > 0.0 ? stim_bench / s : 0.0) << " programs/s, " << (s > 0.0 ? writes / s : 0.0) << " operations/s." << endl;
+        return 0;
+    }
+
+
+    // What is it: The jitter benchmark: the cost per edge of the buffered source against the obvious per-edge implementation, for the
+    //             configured jitter (a 5 ps RJ and one spur if none was given). The sums keep the compiler from dropping either loop.
+    if (jitter_bench > 0) {
+        if (jitter_cfg.rj_rms_ps == 0.0 && jitter_cfg.num_spurs == 0) {
+            jitter_cfg.rj_rms_ps = 5.0;
+            jitter_cfg.spurs[jitter_cfg.num_spurs++] = PllSpur{ 2.0, 25.0 };
+        }
+        const double period_ps = 1250.0;
+
+        PllJitterSource src(jitter_cfg, random_seed, 0);
+        src.set_period_ps(period_ps);
+        double sum_buffered = 0.0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (uint64_t k = 0; k < jitter_bench; ++k) {
+            sum_buffered += src.next();
+        }
+        double s_buffered = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::mt19937_64 eng(random_seed);
+        std::normal_distribution<double> rj(0.0, jitter_cfg.rj_rms_ps);
+        double sum_scalar = 0.0;
+        t0 = std::chrono::steady_clock::now();
+        for (uint64_t k = 0; k < jitter_bench; ++k) {
+            double dev = rj(eng);
+            for (unsigned s = 0; s < jitter_cfg.num_spurs; ++s) {
+                dev += jitter_cfg.spurs[s].amp_ps * std::sin(6.283185307179586 * jitter_cfg.spurs[s].freq_mhz * 1e-6 * period_ps * k);
+            }
+            sum_scalar += dev;
+        }
+        double s_scalar = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        cout << "Buffered source:        " << jitter_bench << " edges in " << s_buffered << " s, "
+             << s_buffered * 1e9 / jitter_bench << " ns/edge (sum " << sum_buffered << ")" << endl;
+        cout << "std::normal_distribution: " << jitter_bench << " edges in " << s_scalar << " s, "
+             << s_scalar * 1e9 / jitter_bench << " ns/edge (sum " << sum_scalar << ")" << endl;
+        cout << "  ";
+        src.print(cout);
+        return 0;
+    }
+
+
+    // What is it: The Monte Carlo mode. The whole population is evaluated outside SystemC, one configuration at a time. Without
+    //             --mc-spot that is all; with it, the first dies of the population go on to the simulation below as the PLLs of the
+    //             system, at the configuration the PMU programs, so the batch kernel is checked against the full SystemC model.
+    PllMonteCarlo            mc(random_seed);
+    std::vector<PllMcBatch>  mc_spot_batch;
+    if (mc_samples > 0) {
+        if (mc_targets.empty()) {
+            const double defaults[] = { 400.0, 800.0, 1200.0, 1600.0 };
+            mc_targets.assign(defaults, defaults + 4);
+        }
+        cout << "Monte Carlo: " << mc_samples << " dies per configuration, seed " << random_seed << "." << endl;
+        for (unsigned t = 0; t < mc_targets.size(); ++t) {
+            PllConfig cfg = { 0, 0, 0 };
+            if (!solve_pll_dividers(mc_targets[t], cfg)) {
+                cout << mc_targets[t] << " MHz: no legal divider configuration." << endl;
+                continue;
+            }
+            PllMcResult res;
+            mc.run(cfg, mc_samples, res);
+            res.print(cout);
+        }
+        if (mc_spot <= 0) {
+            return 0;
+        }
+
+        if (mc_spot > static_cast<int>(PllMcBatch::SIZE)) {
+            mc_spot = PllMcBatch::SIZE;
+        }
+        PllConfig cfg = { 0, 0, 0 };
+        solve_pll_dividers(PMU_TEST_TARGET_MHZ, cfg);
+        mc_spot_batch.resize(1);
+        mc.draw(0, mc_spot, mc_spot_batch[0]);
+        PllMonteCarlo::evaluate(cfg, mc_spot, mc_spot_batch[0]);
+        num_plls = mc_spot;
+    }
+
+
+    // What is it: The netlist of the system: the file given with --netlist, or --plls PLLs in one group. From here on its size is the
+    //             PLL count. The Monte Carlo spot check simulates one PLL per die, so it keeps its own count.
+    PllNetlist netlist = PllNetlist::uniform(num_plls);
+    if (!netlist_path.empty() && mc_spot > 0) {
+        cout << "Ignoring --netlist: --mc-spot simulates one PLL per die." << endl;
+    } else if (!netlist_path.empty()) {
+        if (!netlist.load(netlist_path)) {
+            return 1;
+        }
+        num_plls = netlist.size();
+    }
+    if ((use_bank || bank_check) && netlist.domains.size() > 1) {
+        cout << "The PLL bank has one reset pin: --bank and --bank-check need a netlist with a single reset domain." << endl;
+        return 1;
+    }
+    unsigned reset_domain = 0;
+    if (!domain_reset.empty()) {
+        while (reset_domain < netlist.domains.size() && netlist.domains[reset_domain].name != domain_reset) {
+            reset_domain++;
+        }
+        if (reset_domain == netlist.domains.size()) {
+            cout << "--domain-reset: the netlist has no reset domain '" << domain_reset << "'." << endl;
+            return 1;
+        }
+        if (use_bank || bank_check || netlist.domains.size() < 2) {
+            cout << "--domain-reset needs a netlist with more than one reset domain, and no --bank or --bank-check." << endl;
+            return 1;
+        }
+    }
+
+
     // This message just provides a human-readable marker in the console output to indicate which phase of setup we are in.
     cout << "Instantiating modules..." << endl;
 
@@ -99,13 +540,160 @@ int sc_main(int argc, char* argv[]) {
     //   - '= new pmu_tb(...)': The 'new' operator allocates memory for one 'pmu_tb' object and calls its constructor.
     //   - '"pmu_inst"': This string is passed to the constructor. SystemC uses this unique name to identify the instance in simulation logs
     //                   and waveform viewers, which is crucial for debugging complex systems.
+    std::chrono::steady_clock::time_point build_t0 = std::chrono::steady_clock::now();
     pmu_tb* pmu_inst = new pmu_tb("pmu_inst");
 
-
-
-    //   - 'pll* pll_inst': Declares a pointer named 'pll_inst' for a 'pll' object.
-    //   - '= new pll("pll_inst")': Creates an instance of our PLL Device Under Test (DUT), giving it a unique name.
-    pll* pll_inst = new pll("pll_inst");
+    //   - 'set_test_mode(...)': Selects the scenario the PMU runs after the initial lock, based on the command line.
+    if (dfs_steps > 0) {
+        pmu_inst->set_test_mode(PMU_TEST_DFS);
+        pmu_inst->set_dfs_steps(dfs_steps);
+    }
+    if (!trace_path.empty()) {
+        pmu_inst->set_test_mode(PMU_TEST_TRACE);
+        pmu_inst->set_trace_path(trace_path);
+    }
+    pmu_inst->set_hist_out(hist_out);
+    if (random_count > 0) {
+        pmu_inst->set_test_mode(PMU_TEST_RANDOM);
+        pmu_inst->set_random(random_seed, random_start, random_count);
+    }
+    if (agent_steps > 0) {
+        pmu_inst->set_test_mode(PMU_TEST_AGENTS);
+        pmu_inst->set_agent_steps(agent_steps);
+    }
+    if (reset_mid_lock) {
+        pmu_inst->set_test_mode(PMU_TEST_RESET);
+    }
+    if (!domain_reset.empty()) {
+        pmu_inst->set_test_mode(PMU_TEST_DOMAIN_RESET);
+    }
+    pmu_inst->set_frac(frac);
+
+    //   - 'pll_reset_ctrl resets(...)': The reset tree: the PMU's reset is its root, and every reset domain of the netlist gets its own net.
+    //                                   The PMU starts programming once the last domain is released. It tells the scoreboard about the
+    //                                   resets of a single domain, and the scoreboard knows which PLLs each of them resets.
+    std::vector<unsigned> release_cycles = netlist.release_cycles();
+    pll_reset_ctrl resets("pll_reset_ctrl", release_cycles);
+    pmu_inst->set_reset_release_cycles(*std::max_element(release_cycles.begin(), release_cycles.end()));
+
+
+
+    //   - 'PllTopology topology(...)': Constructs every PLL of the netlist (the DUTs) and their `locked`, `irq` and `clk_out` signals in
+    //                                  one arena, each in its own register window. With the default netlist the first instance keeps the
+    //                                  historical name "pll_inst" so that single-PLL logs and waveforms look exactly as before. With
+    //                                  --bank only the signals are built: the bank drives them.
+    //   - 'std::vector<pll*> plls': The instances, for the per-PLL hooks and reports below.
+    //   - 'set_coverage(...)': Attaches the one functional coverage collector shared by all PLLs.
+    //   - 'set_scoreboard(...)': Connects the PMU (which posts every write) and every PLL (which posts every lock) to the scoreboard.
+    //   - 'set_analog_params(...)': In a Monte Carlo spot-check, makes PLL `i` behave like die `i`, in the DUT and in its reference model.
+    //   - 'lock_timer->attach(...)': Every PLL hands its lock deadlines to the one shared lock timer (`pll_lock_timer.h`), so the kernel
+    //                                has one timed notification for all locking PLLs instead of one per PLL.
+    PllCoverage coverage;
+    PllScoreboard scoreboard(num_plls);
+    pmu_inst->set_scoreboard(&scoreboard);
+    std::chrono::steady_clock::time_point topology_t0 = std::chrono::steady_clock::now();
+    PllTopology topology(netlist, !use_bank);
+    double topology_wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - topology_t0).count();
+
+    std::vector<uint32_t> domain_of(num_plls);
+    for (int i = 0; i < num_plls; ++i) {
+        domain_of[i] = topology.domain_of(i);
+    }
+    scoreboard.set_reset_domains(domain_of);
+    resets.set_scoreboard(&scoreboard);
+    pmu_inst->set_domain_reset(&resets, reset_domain, domain_of);
+
+    std::vector<pll*> plls;
+    pll_lock_timer* lock_timer = topology.has_modules() ? new pll_lock_timer("pll_lock_timer", num_plls) : NULL;
+    std::vector<PllAnalogParams> spot_params;
+    for (int i = 0; i < num_plls; ++i) {
+        if (!mc_spot_batch.empty()) {
+            spot_params.push_back(mc_spot_batch[0].params(i));
+        }
+    }
+    for (int i = 0; i < num_plls && topology.has_modules(); ++i) {
+        pll* p = &topology.instance(i);
+        p->set_coverage(&coverage);
+        p->set_scoreboard(&scoreboard);
+        lock_timer->attach(i, p);
+        if (!spot_params.empty()) {
+            p->set_analog_params(&spot_params[i]);
+            scoreboard.set_analog_params(i, spot_params[i]);
+        }
+        plls.push_back(p);
+    }
+
+    //   - 'new pll_bank(...)': With --bank, all PLLs are one module with the same hooks. With --bank-check, a bank without hooks (but with
+    //                          the same dies) runs next to the `pll` modules, and a compare module watches both.
+    pll_bank* bank = NULL;
+    pll_bank* check_bank = NULL;
+    pll_bank_compare* bank_compare = NULL;
+    if (use_bank) {
+        bank = new pll_bank("pll_bank", num_plls);
+        bank->set_coverage(&coverage);
+        bank->set_scoreboard(&scoreboard);
+        if (!spot_params.empty()) {
+            bank->set_analog_params(spot_params.data());
+            for (int i = 0; i < num_plls; ++i) {
+                scoreboard.set_analog_params(i, spot_params[i]);
+            }
+        }
+    }
+    if (bank_check) {
+        check_bank   = new pll_bank("pll_check_bank", num_plls);
+        bank_compare = new pll_bank_compare("pll_bank_compare", num_plls);
+        if (!spot_params.empty()) {
+            check_bank->set_analog_params(spot_params.data());
+        }
+    }
+
+    //   - 'set_clock_output(...)' / 'set_jitter(...)': With --clk-out, every PLL generates its output clock; with --jitter or --spur,
+    //                                                each through its own noise source (source id = PLL index), owned here.
+    std::vector<PllJitterSource*> jitters;
+    for (int i = 0; i < num_plls && clk_out; ++i) {
+        plls[i]->set_clock_output(true);
+        if (jitter_cfg.rj_rms_ps > 0.0 || jitter_cfg.num_spurs > 0) {
+            jitters.push_back(new PllJitterSource(jitter_cfg, random_seed, i));
+            plls[i]->set_jitter(jitters.back());
+        }
+    }
+
+    //   - 'set_power_meter(...)': With --power, every PLL gets its own energy meter. The vector is sized once, so the pointers stay valid.
+    PllPowerTable power_table;
+    std::vector<PllPowerMeter> power_meters;
+    if (!power_path.empty()) {
+        if (power_path != "default" && !power_table.load(power_path)) {
+            return 1;
+        }
+        power_meters.resize(num_plls);
+        for (int i = 0; i < num_plls && !use_bank; ++i) {
+            plls[i]->set_power_meter(&power_meters[i]);
+        }
+        if (use_bank) {
+            bank->set_power_meters(power_meters.data());
+        }
+    }
+
+    //   - 'set_clock_domain(...)': With --workload, every PLL is the source of its own clock domain, and a `clock_workload` consumes it,
+    //                              directly or, with --clock-mux, through a mux between the PLL and the reference clock.
+    std::vector<ClockDomain*>    clock_domains;
+    std::vector<clock_mux*>      clock_muxes;
+    std::vector<clock_workload*> workloads;
+    for (int i = 0; i < num_plls && workload_cycles > 0; ++i) {
+        clock_domains.push_back(new ClockDomain("clock_domain_" + std::to_string(i)));
+        ClockDomain* consumed = clock_domains.back();
+        if (mux_stages > 0) {
+            clock_muxes.push_back(new clock_mux(("clock_mux_" + std::to_string(i)).c_str(), *consumed, 1e6 / PLL_F_REF_MHZ, mux_stages));
+            consumed = &clock_muxes.back()->output();
+        }
+        workloads.push_back(new clock_workload(("workload_" + std::to_string(i)).c_str(), *consumed, workload_cycles));
+        if (!use_bank) {
+            plls[i]->set_clock_domain(clock_domains.back());
+        }
+    }
+    if (use_bank && !clock_domains.empty()) {
+        bank->set_clock_domains(clock_domains.data());
+    }
 
 
 
@@ -131,7 +719,7 @@ int sc_main(int argc, char* argv[]) {
     //                  This creates a 100 MHz clock (Frequency = 1 / 10 ns).
     // Purpose: This will be the main system clock that drives the sequential logic in both the PMU and the PLL.
 
-    sc_clock clk("clk", 10, SC_NS);
+    sc_clock clk("clk", netlist.clock_period_ns, SC_NS);
 
 
 
@@ -163,7 +751,24 @@ int sc_main(int argc, char* argv[]) {
     //   - 'locked_sig': This wire carries the status signal from the PLL back to the PMU testbench, indicating whether the PLL has
     //                   successfully achieved frequency lock. The testbench will monitor this signal to verify success.
 
-    sc_signal<bool> bus_we_sig, locked_sig;
+    sc_signal<bool> bus_we_sig;
+
+
+
+    // What is it: Three arrays of boolean signals, one entry per PLL, built by the topology builder.
+    // Purpose:
+    //   - 'locked_sigs': Each PLL drives its own lock status wire. The first one is also monitored directly by the PMU.
+    //   - 'irq_sigs':    Each PLL drives its own interrupt request wire into the PMU's `pll_irq` port vector.
+    //   - 'clk_out_sigs': Each PLL's generated output clock. Nothing in this system consumes it yet; it is there to be traced and for
+    //                     downstream models to connect to.
+
+    sc_signal<bool>* locked_sigs  = topology.locked_signals();
+    sc_signal<bool>* irq_sigs     = topology.irq_signals();
+    sc_signal<bool>* clk_out_sigs = topology.clk_out_signals();
+
+    //   - 'check_locked_sigs' / 'check_irq_sigs': The pins of the --bank-check bank, which only the compare module reads.
+    sc_vector<sc_signal<bool>> check_locked_sigs("check_locked_sig", bank_check ? num_plls : 0);
+    sc_vector<sc_signal<bool>> check_irq_sigs("check_irq_sig", bank_check ? num_plls : 0);
 
 
 
@@ -200,31 +805,55 @@ int sc_main(int argc, char* argv[]) {
     pmu_inst->bus_we(bus_we_sig);
 
 
-    // Connects the 'pll_locked' input port of the PMU to the lock status signal. The PMU will monitor this signal.
-    pmu_inst->pll_locked(locked_sig);
+    // Connects the 'pll_locked' input port of the PMU to the lock status signal of the first PLL. The PMU will monitor this signal.
+    pmu_inst->pll_locked(locked_sigs[0]);
 
 
+    // Sizes the PMU's interrupt port vector to the number of PLLs and binds it to the interrupt wires as one range. `init()` must
+    // be called before binding, because it is what actually creates the individual `sc_in<bool>` ports.
+    pmu_inst->pll_irq.init(num_plls);
+    pmu_inst->pll_irq.bind(irq_sigs, irq_sigs + num_plls);
 
-    // Binding the PLL (the DUT) to the very same signals:
-    // Connects the 'clk' input port of the PLL to the same global clock, ensuring both modules are synchronized.
-    pll_inst->clk(clk);
 
 
-    // Connects the 'reset' input port of the PLL to the same reset signal that the PMU drives.
-    pll_inst->reset(reset_sig);
+    // The reset controller reads the system reset and drives the domain nets.
+    resets.clk(clk);
+    resets.reset(reset_sig);
 
 
+    // Binding every PLL (the DUT) in one pass: the clock and the bus fan out to all of them (an 'sc_out' on the PMU connects to an 'sc_in'
+    // on every PLL; the address window decides which PLL actually responds), each PLL's 'reset' goes to the net of its reset domain, and
+    // its 'locked', 'irq' and 'clk_out' ports go to its own wires.
+    topology_t0 = std::chrono::steady_clock::now();
+    topology.bind(clk, resets, bus_addr_sig, bus_wdata_sig, bus_we_sig);
+    topology_wall_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - topology_t0).count();
 
-    // Connects the bus slave input ports of the PLL to the same bus signals that the PMU drives.
-    // An 'sc_out' on the PMU connects to an 'sc_in' on the PLL.
-    pll_inst->bus_addr(bus_addr_sig);
-    pll_inst->bus_wdata(bus_wdata_sig);
-    pll_inst->bus_we(bus_we_sig);
 
-
-
-    // Connects the 'locked' output port of the PLL to the lock status signal. The PLL drives this, and the PMU monitors it.
-    pll_inst->locked(locked_sig);
+    // A bank binds the same shared signals once, and its pin vectors entry by entry. The --bank-check bank and the compare module get
+    // their own wires; the compare module also reads the wires of the `pll` modules.
+    pll_bank* banks[2] = { bank, check_bank };
+    for (int b = 0; b < 2; ++b) {
+        if (banks[b] == NULL) {
+            continue;
+        }
+        banks[b]->clk(clk);
+        banks[b]->reset(resets.domain(0));
+        banks[b]->bus_addr(bus_addr_sig);
+        banks[b]->bus_wdata(bus_wdata_sig);
+        banks[b]->bus_we(bus_we_sig);
+    }
+    for (int i = 0; i < num_plls && bank != NULL; ++i) {
+        bank->locked[i](locked_sigs[i]);
+        bank->irq[i](irq_sigs[i]);
+    }
+    for (int i = 0; i < num_plls && bank_check; ++i) {
+        check_bank->locked[i](check_locked_sigs[i]);
+        check_bank->irq[i](check_irq_sigs[i]);
+        bank_compare->ref_locked[i](locked_sigs[i]);
+        bank_compare->ref_irq[i](irq_sigs[i]);
+        bank_compare->bank_locked[i](check_locked_sigs[i]);
+        bank_compare->bank_irq[i](check_irq_sigs[i]);
+    }
 
 
 
@@ -284,7 +913,11 @@ int sc_main(int argc, char* argv[]) {
     sc_trace(wf, bus_we_sig, "bus_we");
     sc_trace(wf, bus_addr_sig, "bus_addr");
     sc_trace(wf, bus_wdata_sig, "bus_wdata");
-    sc_trace(wf, locked_sig, "locked");
+    sc_trace(wf, locked_sigs[0], "locked");
+    sc_trace(wf, irq_sigs[0], "irq");
+    if (clk_out) {
+        sc_trace(wf, clk_out_sigs[0], "clk_out");
+    }
     // --- END OF TRACING SETUP ---
 
 
@@ -302,8 +935,16 @@ int sc_main(int argc, char* argv[]) {
     // Why is it used: The simulation runs, advancing time and executing processes based on events, until a process calls sc_stop(). In our
     //                 project, the testbench ('pmu_tb') calls sc_stop() when its test scenario is complete. Control then returns to the line
     //                 immediately following sc_start().
+    //
+    // The scoreboard's worker thread is started just before, so it checks in parallel with the simulation; `finish()` afterwards waits
+    // for it to drain its queue and prints the verdict.
 
+    scoreboard.start();
+    std::chrono::steady_clock::time_point sim_t0 = std::chrono::steady_clock::now();
+    double build_wall_s = std::chrono::duration<double>(sim_t0 - build_t0).count();
     sc_start();
+    double sim_wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - sim_t0).count();
+    scoreboard.finish(sc_time_to_ps(sc_time_stamp()));
 
 
 
@@ -313,6 +954,237 @@ int sc_main(int argc, char* argv[]) {
     cout << "Simulation finished at " << sc_time_stamp() << endl;
 
 
+    // What is it: The verdict of the Monte Carlo spot-check. A die that locks must have locked in the simulation within one picosecond
+    //             (the time resolution) of the batch result; a die that cannot lock must not have locked.
+    if (!mc_spot_batch.empty()) {
+        const PllMcBatch& b = mc_spot_batch[0];
+        const std::vector<sc_time>& sim = pmu_inst->initial_lock_times();
+        unsigned agree = 0;
+        for (int i = 0; i < num_plls; ++i) {
+            bool   sim_locked = i < static_cast<int>(sim.size()) && sim[i] != SC_ZERO_TIME;
+            double sim_ns     = sim_locked ? sim[i].to_seconds() * 1e9 : 0.0;
+            bool   ok         = (b.locks[i] != 0.0) ? sim_locked && std::fabs(sim_ns - b.lock_ns[i]) <= 1e-3 : !sim_locked;
+            if (ok) {
+                agree++;
+            } else {
+                cout << "MC_SPOT: die " << i << ": batch " << (b.locks[i] != 0.0 ? "locks in " : "does not lock, ")
+                     << b.lock_ns[i] << " ns, simulation " << (sim_locked ? "locked in " : "did not lock, ") << sim_ns << " ns" << endl;
+            }
+        }
+        if (agree == static_cast<unsigned>(num_plls)) {
+            cout << "MC_SPOT: ✅ PASSED. All " << num_plls << " dies match the batch model." << endl;
+        } else {
+            cout << "MC_SPOT: ❌ FAILED! " << num_plls - agree << " of " << num_plls << " dies differ from the batch model." << endl;
+        }
+    }
+
+
+    // What is it: The verdict of the bank check: the pins agreed at every delta cycle, and the registers and lock frequencies at the end.
+    if (bank_check) {
+        unsigned reg_diff = 0;
+        for (int i = 0; i < num_plls; ++i) {
+            if (plls[i]->divider_n() != check_bank->divider_n(i) || plls[i]->divider_m() != check_bank->divider_m(i) ||
+                plls[i]->divider_od() != check_bank->divider_od(i) || plls[i]->locked_mhz() != check_bank->locked_mhz(i) ||
+                plls[i]->state() != check_bank->state(i) || plls[i]->output_running() != check_bank->output_running(i)) {
+                reg_diff++;
+            }
+        }
+        if (bank_compare->mismatches() == 0 && reg_diff == 0) {
+            cout << "BANK_CHECK: ✅ PASSED. " << num_plls << " PLLs, " << bank_compare->checks()
+                 << " comparisons: the bank and the pll modules agree at every delta cycle and in their final state." << endl;
+        } else {
+            cout << "BANK_CHECK: ❌ FAILED! " << bank_compare->mismatches() << " pin mismatches, " << reg_diff
+                 << " PLLs with a different final state." << endl;
+        }
+    }
+
+
+    // What is it: The check of the reset scenario that the PMU cannot make from the pins: a reset in the middle of a relock must leave
+    //             every PLL switched off, its state machine in OFF and its output clock stopped, and with --workload the clock domain it
+    //             drives stopped too, so that no consumer keeps computing at the period from before the reset.
+    if (reset_mid_lock) {
+        unsigned not_off = 0;
+        for (int i = 0; i < num_plls; ++i) {
+            PllLockState st = use_bank ? bank->state(i) : plls[i]->state();
+            bool         on = use_bank ? bank->output_running(i) : plls[i]->output_running();
+            if (st != PLL_STATE_OFF || on || (unsigned(i) < clock_domains.size() && clock_domains[i]->running())) {
+                not_off++;
+            }
+        }
+        if (not_off == 0) {
+            cout << "RESET_CHECK: ✅ PASSED. Every PLL is off after the reset." << endl;
+        } else {
+            cout << "RESET_CHECK: ❌ FAILED! " << not_off << " PLL(s) are still in a lock state or clocking after the reset." << endl;
+        }
+    }
+
+
+    // What is it: The check of the domain reset scenario that the PMU cannot make from the pins: no PLL outside the reset domain may
+    //             have run its lock sequence since the domain reset (its reset net is another one, so nothing should wake it), and every
+    //             PLL, in the domain or not, must be locked at the end.
+    if (!domain_reset.empty()) {
+        uint64_t start_ps = sc_time_to_ps(pmu_inst->domain_reset_start());
+        unsigned woken = 0, unlocked = 0;
+        for (int i = 0; i < num_plls; ++i) {
+            if (domain_of[i] != reset_domain && plls[i]->last_lock_activation_ps() >= start_ps) {
+                woken++;
+            }
+            if (plls[i]->state() != PLL_STATE_LOCKED) {
+                unlocked++;
+            }
+        }
+        if (start_ps > 0 && woken == 0 && unlocked == 0) {
+            cout << "DOMAIN_RESET_CHECK: ✅ PASSED. No PLL outside domain '" << domain_reset << "' was woken, and every PLL is locked." << endl;
+        } else {
+            cout << "DOMAIN_RESET_CHECK: ❌ FAILED! " << woken << " PLL(s) outside domain '" << domain_reset << "' were woken, "
+                 << unlocked << " PLL(s) are not locked" << (start_ps == 0 ? ", and the domain reset never ran." : ".") << endl;
+        }
+    }
+
+
+    // What is it: The energy report: every PLL's breakdown (the first few, with many PLLs) and the system total, next to the latencies
+    //             the PMU printed.
+    if (!power_meters.empty()) {
+        uint64_t end_ps = sc_time_to_ps(sc_time_stamp());
+        double   total  = 0.0;
+        const unsigned MAX_PRINTED = 8;
+        cout << "POWER: Energy over " << sc_time_stamp() << ":" << endl;
+        for (unsigned i = 0; i < power_meters.size(); ++i) {
+            if (i < MAX_PRINTED) {
+                std::string name = use_bank ? "pll_bank[" + std::to_string(i) + "]" : std::string(plls[i]->name());
+                power_meters[i].print(cout, name, power_table, end_ps);
+            }
+            total += power_meters[i].energy_nj(power_table, end_ps);
+        }
+        if (power_meters.size() > MAX_PRINTED) {
+            cout << "  (" << power_meters.size() - MAX_PRINTED << " more PLLs not shown)" << endl;
+        }
+        cout << "POWER: Total " << total << " nJ";
+        if (end_ps > 0) {
+            cout << ", average " << total / (end_ps * 1e-6) << " mW";
+        }
+        cout << "." << endl;
+    }
+
+
+    // What is it: The work the clock domains' consumers got done, and what it cost: one activation per job and per frequency change,
+    //             against the number of cycles a clocked model would have simulated edge by edge.
+    if (!workloads.empty()) {
+        uint64_t jobs = 0, activations = 0, changes = 0;
+        double   cycles = 0.0;
+        for (unsigned i = 0; i < workloads.size(); ++i) {
+            jobs        += workloads[i]->jobs();
+            cycles      += workloads[i]->cycles();
+            activations += workloads[i]->activations();
+            changes     += clock_domains[i]->changes();
+        }
+        cout << "WORKLOAD: " << workloads.size() << " clock domains, " << jobs << " jobs of " << workload_cycles << " cycles, "
+             << cycles << " cycles executed in " << activations << " activations (" << changes << " frequency changes)." << endl;
+    }
+    if (!clock_muxes.empty()) {
+        uint64_t switches = 0, gated_ps = 0;
+        for (unsigned i = 0; i < clock_muxes.size(); ++i) {
+            switches += clock_muxes[i]->switches();
+            gated_ps += clock_muxes[i]->gated_ps();
+        }
+        cout << "CLOCK_MUX: " << switches << " handovers with " << mux_stages << " sync stages, consumer clocks gated for "
+             << gated_ps / 1000.0 << " ns in total";
+        if (switches > 0) {
+            cout << ", " << gated_ps / 1000.0 / switches << " ns per handover";
+        }
+        cout << "." << endl;
+    }
+
+
+    // What is it: The clock of a fractional-N PLL 0 as its consumers see it, for the dividers it ended the run with: the exact mean
+    //             frequency, the spread of the instantaneous frequency over one block of reference cycles, and the strongest spurs.
+    unsigned frac_0 = use_bank ? bank->divider_frac(0) : plls[0]->divider_frac();
+    if (frac_0 != 0) {
+        int n0  = use_bank ? bank->divider_n(0)  : plls[0]->divider_n();
+        int m0  = use_bank ? bank->divider_m(0)  : plls[0]->divider_m();
+        int od0 = use_bank ? bank->divider_od(0) : plls[0]->divider_od();
+        if (n0 != 0 && od0 != 0) {
+            PllFracN fracn;
+            fracn.configure(n0, m0, frac_0, od0);
+            const double* mhz = fracn.next_block();
+            double lo = mhz[0], hi = mhz[0], sum = 0.0;
+            for (size_t k = 0; k < fracn.block_size(); ++k) {
+                lo   = std::min(lo, mhz[k]);
+                hi   = std::max(hi, mhz[k]);
+                sum += mhz[k];
+            }
+            cout << "FRAC_N: PLL 0 N=" << n0 << " M=" << m0 << " FRAC=" << frac_0 << " OD=" << od0 << ", mean " << fracn.mean_mhz()
+                 << " MHz, instantaneous " << lo << " .. " << hi << " MHz (block mean " << sum / fracn.block_size() << " MHz)." << endl;
+            std::vector<PllFracSpur> lines = fracn.spurs();
+            for (unsigned k = 0; k < lines.size(); ++k) {
+                cout << "FRAC_N:   spur at " << lines[k].offset_mhz << " MHz offset, " << lines[k].dbc << " dBc (before the loop filter)."
+                     << endl;
+            }
+        }
+    }
+
+
+    // What is it: What the jitter sources actually produced, for comparison with the requested specification.
+    for (unsigned i = 0; i < jitters.size(); ++i) {
+        cout << "PLL " << i << " ";
+        jitters[i]->print(cout);
+    }
+
+
+    // What is it: The functional coverage report of the run: what this test actually exercised, as opposed to whether it passed.
+    coverage.report(cout);
+    if (!cov_out.empty() && coverage.save(cov_out)) {
+        cout << "Coverage database saved to '" << cov_out << "'." << endl;
+    }
+
+
+    // What is it: The machine-readable record of the run, one row per PLL, appended to the results file as one block.
+    if (!results_out.empty()) {
+        const std::vector<sc_time>& lock_t = pmu_inst->initial_lock_times();
+        PllResultsTable table;
+        for (int i = 0; i < num_plls; ++i) {
+            PllResultRow r;
+            r.run_id       = run_id;
+            r.pll          = i;
+            r.num_plls     = num_plls;
+            r.mode         = pmu_inst->test_mode_selected();
+            r.seed         = random_seed;
+            r.n            = use_bank ? bank->divider_n(i)  : plls[i]->divider_n();
+            r.m            = use_bank ? bank->divider_m(i)  : plls[i]->divider_m();
+            r.od           = use_bank ? bank->divider_od(i) : plls[i]->divider_od();
+            r.target_mhz   = PMU_TEST_TARGET_MHZ;
+            r.achieved_mhz = use_bank ? bank->locked_mhz(i) : plls[i]->locked_mhz();
+            r.lock_ns      = i < static_cast<int>(lock_t.size()) ? lock_t[i].to_seconds() * 1e9 : 0.0;
+            r.wall_s       = sim_wall_s;
+            r.delta_cycles = sc_delta_count();
+            r.pass         = r.lock_ns > 0.0 && r.achieved_mhz > 0.0;
+            table.append(r);
+        }
+        if (append_results(results_out, table)) {
+            cout << "Results (" << table.rows() << " records) appended to '" << results_out << "'." << endl;
+        }
+    }
+
+
+    // What is it: The cost of the run in host resources. The simulation time includes the end of elaboration, where the kernel creates
+    //             the processes (and the stack of every thread). The peak resident memory is per process, so the part that grows with
+    //             the PLL count is what `make scale-bench` compares across counts.
+    if (resources) {
+        long peak_kb = 0;
+#ifndef _WIN32
+        struct rusage ru;
+        if (getrusage(RUSAGE_SELF, &ru) == 0) {
+            peak_kb = ru.ru_maxrss;     // kB on Linux
+        }
+#endif
+        uint64_t threads = 0, methods = 0;
+        count_processes(sc_get_top_level_objects(), threads, methods);
+        cout << "RESOURCES: " << num_plls << " PLLs, build " << build_wall_s << " s, simulation " << sim_wall_s << " s, "
+             << sc_delta_count() << " delta cycles, peak RSS " << peak_kb << " kB, topology " << topology_wall_s << " s, "
+             << threads << " threads, " << methods << " methods" << endl;
+    }
+
+
 
 
     // What is it: This function closes the VCD trace file handle.
@@ -324,10 +1196,24 @@ int sc_main(int argc, char* argv[]) {
 
 
     // What is it: The C++ 'delete' operator is used to de-allocate memory that was previously allocated with the 'new' operator.
-    // Why is it used: Since we created our 'pll_inst' and 'pmu_inst' objects dynamically on the heap, it is good programming practice
+    // Why is it used: Since we created our 'pmu_inst' and bank objects dynamically on the heap, it is good programming practice
     //                 to explicitly free that memory when we are done with them. This prevents memory leaks in larger, more complex programs
-    //                 where objects might be created and destroyed multiple times.
-    delete pll_inst;
+    //                 where objects might be created and destroyed multiple times. The PLLs and their signals live in the topology's arena,
+    //                 which it frees itself when it goes out of scope.
+    for (PllJitterSource* j : jitters) {
+        delete j;
+    }
+    for (unsigned i = 0; i < workloads.size(); ++i) {
+        delete workloads[i];
+        if (i < clock_muxes.size()) {
+            delete clock_muxes[i];
+        }
+        delete clock_domains[i];
+    }
+    delete bank;
+    delete check_bank;
+    delete bank_compare;
+    delete lock_timer;
     delete pmu_inst;
 
 
@@ -0,0 +1,128 @@
+//
+// File: philox.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header implements Philox4x32-10, the counter-based random number generator of Salmon et al., "Parallel Random Numbers: As Easy as
+// 1, 2, 3" (SC'11). It is the generator behind all randomised stimulus and statistical models in this project.
+//
+// Why a counter-based generator: A conventional generator (`std::mt19937`, an LCG, ...) is a sequence: to get draw number 1,000,000 you
+// have to produce the 999,999 before it. Philox is a pure function instead: random = philox(counter, key). With key = the test seed and
+// counter = the test index, any single test of a million-test sweep can be regenerated on its own, in any order, on any worker, and it
+// will be bit-identical. It is also fast (ten rounds of two 32x32->64 multiplies and a few XORs for 128 random bits) and passes the
+// BigCrush statistical test suite.
+//
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+
+
+#include <cstdint>
+
+
+
+// What is it: 128 bits of output (or input counter) as four 32-bit words.
+struct Philox4x32 {
+    uint32_t v[4];
+};
+
+
+
+// What is it: The Philox4x32 block function with 10 rounds, on the four counter words in place.
+// How it works: Each round multiplies two of the counter words by fixed odd constants, and mixes the high and low halves of the 64-bit
+//               products with the other two words and the key. The key is "bumped" by the Weyl constants between rounds. The constants
+//               are the published ones, so the output matches the reference implementation (Random123) bit for bit.
+// Why four words: A loop that computes many blocks at once (`#pragma omp simd`, see `PllMonteCarlo::draw()`) keeps each word in one
+//                 vector register, a lane per block. A `Philox4x32` local inside such a loop is kept in memory per lane instead, and
+//                 GCC gives up on the loop. The rounds are fully unrolled for the same reason.
+inline void philox4x32_10_words(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint64_t key64) {
+
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;   // round multipliers
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;   // key schedule (golden ratio, sqrt(3) - 1)
+
+    uint32_t k0 = static_cast<uint32_t>(key64);
+    uint32_t k1 = static_cast<uint32_t>(key64 >> 32);
+
+    #pragma GCC unroll 10
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+        uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t>(p1);
+        c3 = static_cast<uint32_t>(p0);
+        c0 = n0;
+        c2 = n2;
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+
+
+// What is it: The same block function on a `Philox4x32` counter, for the callers that draw one block at a time.
+inline Philox4x32 philox4x32_10(Philox4x32 ctr, uint64_t key64) {
+    philox4x32_10_words(ctr.v[0], ctr.v[1], ctr.v[2], ctr.v[3], key64);
+    return ctr;
+}
+
+
+
+// What is it: A convenience wrapper that hands out the random words of one (seed, stream, index) triple one at a time.
+// How it works: The counter is (index low, index high, stream, block). 'stream' separates independent uses of the same seed (stimulus,
+//               Monte Carlo, jitter, ...) so they never share random numbers. If a caller needs more than four words, the block number
+//               is incremented and a fresh 128-bit block is computed; that is still a pure function of (seed, stream, index).
+class PhiloxStream {
+public:
+    PhiloxStream(uint64_t seed, uint32_t stream, uint64_t index) : key(seed), used(4) {
+        ctr.v[0] = static_cast<uint32_t>(index);
+        ctr.v[1] = static_cast<uint32_t>(index >> 32);
+        ctr.v[2] = stream;
+        ctr.v[3] = 0;
+    }
+
+    uint32_t next_u32() {
+        if (used == 4) {
+            block = philox4x32_10(ctr, key);
+            ctr.v[3]++;
+            used = 0;
+        }
+        return block.v[used++];
+    }
+
+    // What is it: A uniform integer in [0, n). Uses Lemire's multiply-shift reduction, which has no division and a bias of at most
+    //             n / 2^32 -- irrelevant for the ranges used here (a few hundred values).
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(next_u32()) * n) >> 32);
+    }
+
+    // What is it: A uniform double in [0, 1) with 32 bits of resolution.
+    double uniform() {
+        return next_u32() * (1.0 / 4294967296.0);
+    }
+
+private:
+    uint64_t   key;
+    Philox4x32 ctr;
+    Philox4x32 block;
+    unsigned   used;
+};
+
+
+
+// The stream numbers in use, so that no two features draw from the same random numbers by accident.
+#define PHILOX_STREAM_STIMULUS    1
+#define PHILOX_STREAM_MONTE_CARLO 2
+#define PHILOX_STREAM_JITTER      3
+
+
+
+// The angle scale of the Box-Muller transform that turns pairs of Philox uniforms into normal variates (Monte Carlo, jitter).
+#define PHILOX_TWO_PI 6.283185307179586
+
+
+#endif // PHILOX_H
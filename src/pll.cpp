@@ -17,8 +17,8 @@
 //       internal configuration registers (`reg_m`, `reg_n`, etc.) based on the address and data provided by the testbench.
 //
 //   2.  `locking_process`: This is a time-consuming, stateful process that models the physical, analog behavior of the PLL achieving lock.
-//       It is triggered by an event from the `bus_process` but then suspends itself using a timed `wait()` to simulate the real-world
-//       delay (e.g., 500 nanoseconds). This accurately models the performance characteristics of the DUT.
+//       It is triggered by an event from the `bus_process` and then schedules its own next activation with a timed `next_trigger()` to
+//       simulate the real-world delay (e.g., 500 nanoseconds). This accurately models the performance characteristics of the DUT.
 //
 // The two processes communicate via an internal `sc_event`, which elegantly decouples the fast digital configuration from the slow analog locking,
 // a core concept in high-level performance modeling.
@@ -39,6 +39,58 @@
 //               produce an error. It's the essential link between declaration and implementation.
 #include "pll.h"
 
+// The functional coverage collector, sampled from both processes when one is attached.
+#include "pll_coverage.h"
+
+// The scoreboard, which receives every lock (with its output period) to check against the reference model.
+#include "pll_scoreboard.h"
+
+// `sc_time_to_ps()`, for the time stamps posted to the scoreboard and the power meter.
+#include "pll_time.h"
+
+// The parametric lock-time model, used instead of the fixed acquisition time when a die's analog parameters are attached.
+#include "pll_lock_model.h"
+
+// The period-jitter source of the output clock.
+#include "pll_jitter.h"
+
+// The power meter, which is told about every state transition and bus write.
+#include "pll_power.h"
+
+// The clock domain, which is told the output period on every lock, relock and disable.
+#include "clock_domain.h"
+
+// The shared lock timer, which holds the lock deadline when one is attached.
+#include "pll_lock_timer.h"
+
+// `std::isfinite`, to keep a degenerate divider setting (infinite period) from driving the output clock.
+#include <cmath>
+
+
+
+
+// What is it: The definition of the static `verbose` flag declared in `pll.h`. A static data member is shared by every `pll` instance
+//             and must be defined in exactly one translation unit. Logging is on by default, exactly as before.
+bool pll::verbose = true;
+
+
+
+// What is it: Moves the lock state machine to 'next'. Coverage records the transition; the power meter closes the time interval of the
+//             previous state, and for LOCKED learns the output frequency, which sets the locked power.
+void pll::state_to(PllLockState next) {
+    if (coverage != NULL) {
+        coverage->sample_state(lock_state, next);
+    }
+    if (power != NULL) {
+        double out_mhz = 0.0;
+        if (next == PLL_STATE_LOCKED && reg_n != 0 && reg_od != 0) {
+            out_mhz = (PLL_F_REF_MHZ * (reg_m + double(reg_frac) / PLL_FRAC_ONE)) / (reg_n * reg_od);
+        }
+        power->transition(next, out_mhz, sc_time_to_ps(sc_time_stamp()));
+    }
+    lock_state = next;
+}
+
 
 
 
@@ -55,7 +107,7 @@
 // Role in the project:
 // This function was registered as an 'SC_METHOD' in the constructor (in pll.h). An SC_METHOD is a process that models reactive or
 // combinational logic. It executes instantaneously (in zero simulation time) whenever an event occurs on a signal in its sensitivity list
-// (in our case, a positive edge of the 'clk' or a change on the 'reset' signal). This makes it perfect for modeling the digital logic
+// (in our case, a positive edge of the 'clk' or of the 'reset' signal). This makes it perfect for modeling the digital logic
 // of a register file that should respond immediately to bus commands on a clock edge.
 void pll::bus_process() {
 
@@ -65,8 +117,10 @@ void pll::bus_process() {
     //================================================================================================================================
     // What is it: This 'if' statement checks the current value of the reset signal. In this design, the reset is "active-high", meaning
     //             the reset condition is active when the signal's value is high (true or 1).
-    // How is it triggered: Since this entire 'bus_process' is an SC_METHOD sensitive to the clock, this check effectively models a
-    //                     *synchronous* reset. The reset condition is only evaluated and acted upon at a positive clock edge.
+    // How is it triggered: The first activation with the reset high (its rising edge, or a clock edge if it was already high at time
+    //                     zero) is the reset entry: it clears the registers once, and then, with `next_trigger(reset.negedge_event())`,
+    //                     suspends the process until the reset is released. The clock edges in between do not wake it: holding the
+    //                     reset for a thousand cycles costs the same as holding it for one, for every PLL on the bus.
     // Why is it used: Resetting a hardware module is the most critical first step. It ensures that all internal state registers are
     //               put into a known, predictable state before normal operation begins. This prevents unknown or random values from
     //               causing unpredictable behavior at startup. It's the "master override" for the module.
@@ -80,7 +134,17 @@ void pll::bus_process() {
         //   - 'reg_m', 'reg_n', 'reg_od': These are the divider registers. Setting them to 0 ensures they don't hold garbage values from
         //                                 the previous simulation run.
         //   - 'pll_enable': This internal boolean flag, which controls the locking process, is explicitly set to false.
-        reg_m = 0; reg_n = 0; reg_od = 0; pll_enable = false;
+        reg_m = 0; reg_n = 0; reg_od = 0; reg_frac = 0; pll_enable = false; dfs_enable = false;
+
+        // The interrupt registers return to their reset values too. The `irq` pin itself is driven by `irq_process`, so we only
+        // notify it here instead of writing the port from this process.
+        irq_status = 0; irq_enable = PLL_IRQ_LOCK_DONE;
+        cov_last_slot = PLL_SLOT_NONE;
+        irq_update_event.notify(SC_ZERO_TIME);
+
+        // The lock sequence has to stop as well. An idle `locking_process` sees the reset edge itself, but one in the middle of a timed
+        // lock wait (or a die that cannot lock, waiting in ACQUIRE) is only sensitive to `start_locking_event`, exactly as for a disable.
+        start_locking_event.notify(SC_ZERO_TIME);
 
 
 
@@ -91,17 +155,31 @@ void pll::bus_process() {
 
         // The following 'cout' statements are for debugging and creating a clear log. They confirm in the console output that the reset
         // was received and that the internal state has been cleared, which helps in correlating the log with the waveform.
-        cout << "@" << sc_time_stamp() << ": PLL received write to REG[3] with data 0x0" << endl;
-        cout << "@" << sc_time_stamp() << ": PLL received write to REG[2] with data 0x0" << endl;
-        cout << "@" << sc_time_stamp() << ": PLL received write to REG[1] with data 0x0" << endl;
-        cout << "@" << sc_time_stamp() << ": PLL received write to REG[0] with data 0x0" << endl;
+        if (verbose) {
+            cout << "@" << sc_time_stamp() << ": PLL received write to REG[3] with data 0x0" << endl;
+            cout << "@" << sc_time_stamp() << ": PLL received write to REG[2] with data 0x0" << endl;
+            cout << "@" << sc_time_stamp() << ": PLL received write to REG[1] with data 0x0" << endl;
+            cout << "@" << sc_time_stamp() << ": PLL received write to REG[0] with data 0x0" << endl;
+        }
 
 
 
         // What is it: The 'return' keyword is a C++ statement that immediately exits the current function.
         // Why is it used here: This is a crucial piece of logic. If the module is in reset, we must not execute any of the normal bus
         //                    write logic that follows. The 'return' statement ensures that after handling the reset, the function
-        //                    terminates, effectively giving the reset condition the highest priority.
+        //                    terminates, effectively giving the reset condition the highest priority. The dynamic sensitivity replaces
+        //                    the static list (clock and reset edges) until the next activation, which is the reset exit below.
+        in_reset = true;
+        next_trigger(reset.negedge_event());
+        return;
+    }
+
+
+
+    // The reset exit: this activation is the falling edge of the reset, not a clock edge, so there is no bus cycle to sample. The next
+    // activation comes from the static sensitivity again.
+    if (in_reset) {
+        in_reset = false;
         return;
     }
 
@@ -120,21 +198,32 @@ void pll::bus_process() {
     if (bus_we.read() == true) {
 
 
+        // What is it: The address window check.
+        // Why is it used: When several PLLs share the bus, each one must only react to writes inside its own window. The upper address
+        //               bits select the PLL, the lower bits select the register. A write to another PLL's window is silently ignored,
+        //               exactly like a real address decoder whose chip-select is not asserted.
+        sc_uint<32> addr = bus_addr.read();
+        if ((addr & ~sc_uint<32>(PLL_ADDR_WINDOW - 1)) != base_addr) {
+            return;
+        }
+        sc_uint<32> offset = addr & (PLL_ADDR_WINDOW - 1);
+
+
         // This is a local variable used for creating a more descriptive log message. It's not part of the hardware logic itself.
         // What is it: An 'int' is a standard C++ data type for a signed integer. Here I'm declaring a variable 'reg_index'.
-        // How is it used: It takes the 32-bit bus address (e.g., 0x0, 0x4, 0x8) and divides by 4 to get a simple index (0, 1, 2),
+        // How is it used: It takes the register offset (e.g., 0x0, 0x4, 0x8) and divides by 4 to get a simple index (0, 1, 2),
         //                 which is easier to print in the log.
         // Memory: As a local variable inside a function, its memory is allocated on the stack and is automatically freed when the function exits.
 
-        int reg_index = bus_addr.read() / 4; // Convert address to index 0,1,2,3
+        int reg_index = offset / 4; // Convert address to index 0,1,2,3,...
 
 
 
         // What is it: The 'switch' statement is a C++ control flow structure that provides a clean way to perform different actions
         //             based on the value of a single variable.
-        // Why is it used: It's the ideal way to model a hardware address decoder. It checks the value on the 'bus_addr' signal and
-        //               executes the code block corresponding to that specific address.
-        switch (bus_addr.read()) {
+        // Why is it used: It's the ideal way to model a hardware address decoder. It checks the register offset inside this PLL's
+        //               window and executes the code block corresponding to that specific register.
+        switch (offset) {
 
 
 
@@ -144,185 +233,398 @@ void pll::bus_process() {
             case PLL_REG_N_ADDR:  reg_n = bus_wdata.read(); break;
 
             // This case handles writes to the 'M' divider register.
-            case PLL_REG_M_ADDR:  reg_m = bus_wdata.read(); break;
+            //
+            // Dynamic Frequency Scaling (DFS) fast path: if the PLL is enabled, in DFS mode and already in lock, a new M value is a
+            // frequency hop of the running loop. We do NOT go through the disable/enable cycle (which would drop the output and cost
+            // the full acquisition time); instead we compute a settling time from the size of the hop and restart the locking
+            // process with it. Steps larger than `PLL_DFS_MAX_STEP` are still taken without disabling, but need the full lock time.
+            case PLL_REG_M_ADDR: {
+                sc_uint<8> new_m = bus_wdata.read();
+
+                if (pll_enable && dfs_enable && lock_achieved && new_m != reg_m) {
+                    int step = (new_m > reg_m) ? int(new_m - reg_m) : int(reg_m - new_m);
+
+                    if (step <= PLL_DFS_MAX_STEP) {
+                        pending_lock_time = sc_time(PLL_DFS_SETTLE_BASE_NS + PLL_DFS_SETTLE_NS_PER_STEP * step, SC_NS);
+                    } else {
+                        pending_lock_time = sc_time(PLL_LOCK_TIME_NS, SC_NS);
+                    }
+                    dfs_from_m = reg_m;
+                    start_locking_event.notify(SC_ZERO_TIME);
+                }
+
+                reg_m = new_m;
+                break;
+            }
 
             // This case handles writes to the 'OD' divider register.
             case PLL_REG_OD_ADDR: reg_od = bus_wdata.read(); break;
 
+            // This case handles writes to the fractional divider register; only the low `PLL_FRAC_BITS` bits are kept.
+            case PLL_REG_FRAC_ADDR: reg_frac = bus_wdata.read() & (PLL_FRAC_ONE - 1); break;
+
 
             // This case handles writes to the control register, which has special logic.
             case PLL_REG_CTRL_ADDR:
 
-                // If the data written is '1', we are enabling the PLL.
-                if (bus_wdata.read() == 1) {
-
-                    // We set our internal state flag to true.
-                    pll_enable = true;
-
-
-                    // WHAT IS IT: This is the most important concept for decoupling fast and slow processes. 'start_locking_event' is an 'sc_event' object.
-                    //             The '.notify()' function immediately schedules that event to occur.
-                    // WHY IS IT USED: The bus write is an instantaneous digital event. The PLL locking is a slow, physical event. We do not want
-                    //                 this fast bus process to get stuck waiting for the lock. By notifying an event, this function can finish
-                    //                 its job instantly, and the separate 'locking_process' (which is sensitive to this event) will be woken
-                    //                 up by the SystemC kernel to begin its long task in parallel.
-                    start_locking_event.notify(SC_ZERO_TIME);
+                // The DFS mode bit is a plain configuration bit; it can be changed at any time without affecting the lock.
+                dfs_enable = (bus_wdata.read() & PLL_CTRL_DFS_EN) != 0;
+
+                // If the enable bit is '1', we are enabling the PLL. Only the 0 -> 1 transition starts a (full) lock sequence, so
+                // that software can flip the DFS bit on a running PLL without knocking it out of lock.
+                if ((bus_wdata.read() & PLL_CTRL_ENABLE) != 0) {
+
+                    if (!pll_enable) {
+
+                        // We set our internal state flag to true.
+                        pll_enable = true;
+
+                        // A fresh enable always needs the full acquisition time: the datasheet value, or what the lock-time model
+                        // gives for this die and the dividers programmed right now.
+                        pending_lock_time = sc_time(PLL_LOCK_TIME_NS, SC_NS);
+                        lock_possible     = true;
+                        if (analog != NULL) {
+                            PllConfig cfg = { int(reg_m), int(reg_n), int(reg_od) };
+                            PllLockResult r = pll_lock_model(*analog, cfg);
+                            pending_lock_time = sc_time(r.lock_ns, SC_NS);
+                            lock_possible     = r.locks;
+                        }
+
+
+                        // WHAT IS IT: This is the most important concept for decoupling fast and slow processes. 'start_locking_event' is an 'sc_event' object.
+                        //             The '.notify()' function immediately schedules that event to occur.
+                        // WHY IS IT USED: The bus write is an instantaneous digital event. The PLL locking is a slow, physical event. We do not want
+                        //                 this fast bus process to get stuck waiting for the lock. By notifying an event, this function can finish
+                        //                 its job instantly, and the separate 'locking_process' (which is sensitive to this event) will be woken
+                        //                 up by the SystemC kernel to begin its long task in parallel.
+                        start_locking_event.notify(SC_ZERO_TIME);
+                    }
                 } else {
 
 
-                    // If the data written is not '1', we disable the PLL.
+                    // If the enable bit is '0', we disable the PLL.
                     pll_enable = false;
 
-                    // Disabling the PLL should cause it to immediately lose its lock status. We write 'false' to the output port.
-                    locked.write(false);
+                    // Disabling the PLL should cause it to immediately lose its lock status. Rather than writing the `locked` port from
+                    // this process (which would give the signal a second driver), we wake the `locking_process`, which sees that the
+                    // PLL is no longer enabled, aborts any sequence in flight and drives `locked` low in the same time step.
+                    start_locking_event.notify(SC_ZERO_TIME);
                 }
                 break; // The 'break' statement exits the switch block.
+
+
+            // This case handles the write-1-to-clear interrupt status register. Only the bits written as '1' are cleared, so the PMU
+            // can acknowledge one cause without accidentally losing another one that fired in the meantime.
+            case PLL_REG_IRQ_STATUS_ADDR:
+                irq_status = irq_status & ~bus_wdata.read();
+                irq_update_event.notify(SC_ZERO_TIME);
+                break;
+
+            // This case handles the interrupt enable (mask) register.
+            case PLL_REG_IRQ_ENABLE_ADDR:
+                irq_enable = bus_wdata.read();
+                irq_update_event.notify(SC_ZERO_TIME);
+                break;
         }
 
 
         // This is a logging statement for debug. It prints the time, the register index we calculated, and the data that was written
         // in hexadecimal format for easy reading. The `hex` and `dec` are C++ stream manipulators.
-        cout << "@" << sc_time_stamp() << ": PLL received write to REG[" << reg_index << "] with data 0x" << hex << bus_wdata.read() << dec << endl;
+        if (coverage != NULL) {
+            cov_last_slot = coverage->sample_write(offset, bus_wdata.read(), cov_last_slot);
+        }
+        if (power != NULL) {
+            power->bus_write();
+        }
+
+        if (verbose) cout << "@" << sc_time_stamp() << ": PLL received write to REG[" << reg_index << "] with data 0x" << hex << bus_wdata.read() << dec << endl;
     }
 }
 
 
 
 //================================================================================================================================
-// Process 2: Timed Locking Behavior (`SC_THREAD`)
+// Process 2: Timed Locking Behavior (`SC_METHOD` state machine)
 //================================================================================================================================
 // What is it: This is the function definition for the 'locking_process' member function of the 'pll' class.
 // Role in the project:
-// This function was registered as an 'SC_THREAD' in the constructor. An SC_THREAD is a process that can be suspended and resumed,
-// making it perfect for modeling behavior that takes a non-zero amount of simulation time. This process models the physical,
-// analog nature of the PLL, which does not lock instantaneously.
+// This process models the physical, analog nature of the PLL, which does not lock instantaneously. It is registered as an 'SC_METHOD'
+// and takes simulated time with `next_trigger()` instead of `wait()`: every activation runs to the end and tells the kernel what should
+// wake it next. An SC_THREAD would keep its position in the code between activations, but it needs its own coroutine stack for that and
+// a context switch on every wake, which with hundreds or thousands of PLLs is the largest memory cost of the model.
+//
+// How it works: The position a thread would be suspended at is kept in `lock_timer_armed`, the one state this method needs:
+//   - false: waiting for a command. The next activation comes from the static sensitivity (`reset.pos()`, `start_locking_event`), or
+//            from `start_locking_event` alone while a die that cannot lock sits in ACQUIRE. Either way the current state is evaluated
+//            from scratch.
+//   - true:  waiting for the lock time, with `next_trigger(lock_time, start_locking_event)`. `timed_out()` tells the two wake-ups
+//            apart, exactly as it did after the thread's `wait(lock_time, start_locking_event)`.
+// A reset notifies `start_locking_event` too (see `bus_process`), so it ends a lock wait at once: the PLL is switched off in the
+// reset, not when a lock time it will never complete runs out.
 void pll::locking_process() {
 
+    last_activation_ps = sc_time_to_ps(sc_time_stamp());
+
+    // What is it: The end of a timed lock wait.
+    // How it works: If the lock time has elapsed, the lock completes and the method returns without calling `next_trigger()`, which
+    //               hands it back to its static sensitivity. If `start_locking_event` came first, a new command or a reset arrived
+    //               mid-sequence: we fall through and start over with the new state. A lock that is no longer wanted when its time is up
+    //               (the PLL was disabled or reset) falls through as well, and the state below switches the PLL off. With the shared
+    //               lock timer, the timer says whether the deadline was reached, and a deadline that was not is cancelled there.
+    if (lock_timer_armed) {
+        lock_timer_armed = false;
+        bool elapsed = timed_out();
+        if (lock_timer != NULL) {
+            elapsed           = lock_deadline_due;
+            lock_deadline_due = false;
+            if (!elapsed) {
+                lock_timer->cancel(lock_timer_id);
+            }
+        }
+        if (elapsed && pll_enable && reset.read() == false) {
+            complete_lock();
+            return;
+        }
+    }
+
 
-    // What is it: A 'while(true)' loop creates an infinite loop.
-    // Why is it used: In hardware, logic blocks are "always on", constantly waiting for a trigger. This infinite loop models that
-    //               persistent nature. The process will run forever, but it will spend most of its time suspended by the 'wait()'
-    //               statement inside it, so it doesn't consume CPU resources unnecessarily.
-    while (true) {
+    // What is it: One lock (or relock) sequence, evaluated from the current state.
+    // Why is it used: With DFS, the bus can re-target the loop, or disable it, while we are in the middle of a timed wait. Every
+    //               activation re-evaluates the current state from scratch; the `return` statements end it once the PLL has either
+    //               been switched off or is waiting for the next event.
 
+    // This 'if' checks the conditions that force the PLL out of lock: the reset is active, or the PLL has been disabled.
+    if (reset.read() == true || !pll_enable) {
 
-        // What is it: The 'wait()' statement is a core SystemC function that suspends the execution of an SC_THREAD.
-        // How is it used: When called without arguments, it suspends the process until any event on its static sensitivity list
-        //                 (defined in the constructor) occurs. For this process, it will wait here indefinitely until either the 'reset'
-        //                 signal changes or the 'start_locking_event' is notified.
+        // The PLL cannot be locked. We drive the 'locked' output port to low (false).
+        // This process is the sole driver of the 'locked' signal, including during reset and disable, to avoid multiple drivers.
+        locked.write(false);
+        lock_achieved = false;
+        if (lock_state != PLL_STATE_OFF) state_to(PLL_STATE_OFF);
 
-        wait(); // Wait for reset or start_locking_event
+        // No lock, no output clock.
+        out_period_ps = 0.0;
+        clk_out_event.notify(SC_ZERO_TIME);
+        update_clock_domain(false);
+        return;
+    }
 
 
-        // This 'if/else if' structure creates a priority-encoded logic block. The reset condition is checked first.
-        
-        // This checks if the event that woke up the process was a change on the reset signal where its new value is true.
-        if (reset.read() == true) {
+    // The duration of this sequence was decided by the 'bus_process' when it woke us up: the full acquisition time for a
+    // fresh enable, or a shorter settling time for a DFS frequency hop.
+    sc_time lock_time = pending_lock_time;
 
-            // If we are in reset, the PLL cannot be locked. We drive the 'locked' output port to low (false).
-            // This is the sole responsibility of this process for the 'locked' signal during reset to avoid multiple drivers.
-            locked.write(false);
 
+    // These 'cout' statements provide a clear log of the process's state for debugging. A PLL that is already in lock when
+    // the sequence starts is performing a DFS relock; otherwise this is a normal acquisition after enable.
+    if (!verbose) {
+        // Logging is switched off for long runs; nothing to print.
+    } else if (lock_achieved) {
+        cout << "@" << sc_time_stamp() << ": PLL DFS step M " << dfs_from_m.to_uint() << " -> " << reg_m.to_uint()
+             << ". Fast relock, settling for " << lock_time << "." << endl;
+    } else {
+        cout << "@" << sc_time_stamp() << ": PLL enabled. Starting lock sequence." << endl;
+        cout << "@" << sc_time_stamp() << ": PLL is in LOCKING state. Waiting for " << lock_time << "." << endl;
+    }
 
-        // If the process was triggered and it was NOT a reset, it must have been the 'start_locking_event'.
-        // We also check our internal 'pll_enable' flag, which was set by the 'bus_process'.
-        } else if (pll_enable) {
 
+    // Coverage: the state machine enters ACQUIRE (or RELOCK for a DFS hop from lock), with this divider configuration.
+    state_to(lock_achieved ? PLL_STATE_RELOCK : PLL_STATE_ACQUIRE);
+    if (coverage != NULL) {
+        coverage->sample_lock_start(reg_n, reg_m, reg_od);
+    }
 
-            // The first step in a new lock sequence is to assert that the PLL is no longer locked to its previous frequency.
-            // We drive the 'locked' output low.
-            locked.write(false);
 
-            // These 'cout' statements provide a clear log of the process's state for debugging.
-            cout << "@" << sc_time_stamp() << ": PLL enabled. Starting lock sequence." << endl;
-            cout << "@" << sc_time_stamp() << ": PLL is in LOCKING state. Waiting for 500 ns." << endl;
+    // The first step in a new lock sequence is to assert that the PLL is no longer locked to its previous frequency.
+    // We drive the 'locked' output low. During a DFS hop the output clock keeps running while the loop slews to the new
+    // frequency (the hop is glitch-free); only the lock detector reports "not locked" until the loop has settled.
+    locked.write(false);
+    lock_achieved = false;
+    update_clock_domain(false);
 
 
+    // A die whose VCO cannot reach the target frequency never locks. It stays in ACQUIRE until the next command.
+    if (!lock_possible) {
+        next_trigger(start_locking_event);
+        return;
+    }
 
 
-            //================================================================================================================================
-            // Modeling Real-World Time Delay (Performance Modeling)
-            //================================================================================================================================
-            // What is it: This is a call to a timed version of the SystemC 'wait()' function. This is the single most important line of code
-            //             for modeling performance.
-            // How is it used: Unlike the parameter-less 'wait()' that waits for an event, this version 'wait(time_value, time_unit)' instructs
-            //                 the SystemC simulation kernel to suspend this specific process ('locking_process') and only resume it after the
-            //                 specified amount of simulation time has passed. Here, it waits for 500 nanoseconds (SC_NS).
-            // Why is it used: This is the core of high-level architectural modeling. In the real world, a physical PLL does not lock instantly.
-            //                 It takes a specific amount of time for the internal analog circuits to stabilize. This line models that physical
-            //                 delay. By including this, our simulation can be used to answer critical system-level questions, such as "How
-            //                 long does our system's boot sequence take?", because we are accurately accounting for the time consumed by
-            //                 this component. This is a capability that an 'SC_METHOD' (like bus_process) does not have, which is why we
-            //                 chose an 'SC_THREAD' for this process. While this process is "sleeping" for 500ns, the rest of the simulation
-            //                 (e.g., other modules) can continue to run.
 
 
+    //================================================================================================================================
+    // Modeling Real-World Time Delay (Performance Modeling)
+    //================================================================================================================================
+    // What is it: This is a call to a timed version of the SystemC 'next_trigger()' function. This is the single most important line
+    //             of code for modeling performance.
+    // How is it used: The 'next_trigger(time_value, event)' form instructs the SystemC simulation kernel to run this specific process
+    //                 ('locking_process') again when the lock time has passed OR 'start_locking_event' is notified again, whichever
+    //                 comes first. 'timed_out()' in that activation tells us which of the two it was.
+    // Why is it used: This is the core of high-level architectural modeling. In the real world, a physical PLL does not lock instantly.
+    //                 It takes a specific amount of time for the internal analog circuits to stabilize. This line models that physical
+    //                 delay. By including this, our simulation can be used to answer critical system-level questions, such as "How
+    //                 long does our system's boot sequence take?", because we are accurately accounting for the time consumed by
+    //                 this component. The event half of the trigger lets a disable, a reset or a new DFS step abort the sequence
+    //                 immediately, instead of being noticed only after the full delay.
+    //                 While this process is "sleeping", the rest of the simulation (e.g., other modules) can continue to run.
+    // With the shared lock timer attached, the deadline goes into its wheel instead of the kernel's event queue, and the process waits
+    // for the timer's `lock_deadline_event` in place of the timeout.
+    lock_timer_armed = true;
+    if (lock_timer != NULL) {
+        lock_timer->schedule(lock_timer_id, sc_time_to_ps(sc_time_stamp()) + sc_time_to_ps(lock_time));
+        next_trigger(start_locking_event | lock_deadline_event);
+    } else {
+        next_trigger(lock_time, start_locking_event);
+    }
+}
 
 
-            // Use the 500 ns lock time from the target output.
-            wait(500, SC_NS);
 
+// What is it: The lock-time-elapsed half of the lock sequence, run by `locking_process` when its timed trigger expires.
+void pll::complete_lock() {
+    //================================================================================================================================
+    // Post-Delay Output Generation
+    //================================================================================================================================
+    // `locking_process` only calls this while the PLL is still enabled and out of reset; a lock that is no longer wanted is switched off
+    // there instead.
 
-            //================================================================================================================================
-            // Post-Delay State Check and Output Generation
-            //================================================================================================================================
-            // What is it: This 'if' statement re-checks the 'pll_enable' flag AFTER the 500ns wait has completed.
-            // Why is it used: This is a subtle but critical piece of logic for creating a robust model. It's possible that while the PLL was
-            //                 in the middle of its 500ns locking sequence, the testbench sent another command to the control register to
-            //                 *disable* the PLL. If that happened, 'pll_enable' would now be false. This check ensures that we only
-            //                 assert the 'locked' signal if the PLL is still supposed to be active when the lock time elapses. It correctly
-            //                 models a scenario where the lock attempt is aborted mid-sequence.
+    // We now drive the 'locked' output port to high (true), signaling to the rest of the system
+    // that a stable clock is available. The testbench is waiting for this event.
+    locked.write(true);
+    lock_achieved = true;
+    state_to(PLL_STATE_LOCKED);
 
-            if (pll_enable) {
+    // At the same instant, latch the lock-done interrupt cause. The `irq_process` turns this into a level on the `irq` pin
+    // (if the cause is enabled), which the PMU can wait on together with the interrupts of every other PLL in the system.
+    // A completed DFS relock raises the same cause, so the PMU measures both paths in exactly the same way.
+    irq_status = irq_status | PLL_IRQ_LOCK_DONE;
+    irq_update_event.notify(SC_ZERO_TIME);
 
+    // This is a purely informational log message confirming the lock time has passed.
+    if (verbose) cout << "@" << sc_time_stamp() << ": PLL lock time elapsed." << endl;
 
-                // If the PLL is still enabled, we now drive the 'locked' output port to high (true), signaling to the rest of the system
-                // that a stable clock is available. The testbench is waiting for this event.
-                locked.write(true);
 
-                // This is a purely informational log message confirming the lock time has passed.
-                cout << "@" << sc_time_stamp() << ": PLL lock time elapsed." << endl;
-                
 
 
+    // This block of code performs a calculation to provide a highly informative debug message. This is not part of the
+    // hardware logic, but it's an excellent verification practice.
 
+    // 'const double F_REF_MHZ': Declares a constant variable to hold the reference frequency of 25 MHz (`PLL_F_REF_MHZ` from
+    // the datasheet in pll.h). 'const' is a C++ keyword ensuring this value cannot be accidentally changed. 'double' is a C++ data type for double-precision
+    // floating-point numbers, suitable for calculations.
+    const double F_REF_MHZ = PLL_F_REF_MHZ;
 
-                // Add the descriptive lock message with calculated frequency.
 
+    // This line calculates the final output frequency based on the standard PLL formula: F_out = F_ref * M / (N * OD).
+    // It uses the internal register values that were programmed by the testbench. In fractional-N mode M is M + FRAC / 2^24, the
+    // mean of the dithered divider.
+    double f_out_mhz = (F_REF_MHZ * (reg_m + double(reg_frac) / PLL_FRAC_ONE)) / (reg_n * reg_od);
 
 
 
-                // This block of code performs a calculation to provide a highly informative debug message. This is not part of the
-                // hardware logic, but it's an excellent verification practice.
-                
-                // 'const double F_REF_MHZ': Declares a constant variable to hold the reference frequency of 25 MHz. 'const' is a C++
-                // keyword ensuring this value cannot be accidentally changed. 'double' is a C++ data type for double-precision
-                // floating-point numbers, suitable for calculations.
-                const double F_REF_MHZ = 25.0;
+    // This line calculates the period of the output clock in nanoseconds (Period = 1 / Frequency).
+    double period_ns = 1000.0 / f_out_mhz; // (1000.0 because F is in MHz)
 
 
-                // This line calculates the final output frequency based on the standard PLL formula: F_out = F_ref * M / (N * OD).
-                // It uses the internal register values that were programmed by the testbench.
-                double f_out_mhz = (F_REF_MHZ * reg_m) / (reg_n * reg_od);
+    // This final 'cout' statement prints a rich, self-verifying message. Instead of just saying "Locked", it says "Locked"
+    // AND it reports the period of the clock it is now generating. This allows a human reading the log to instantly
+    // confirm that the PLL locked to the CORRECT frequency, not just an arbitrary one.
+    if (verbose) cout << "@" << sc_time_stamp() << ": PLL LOCKED. Generating output clock with period " << period_ns << " ns." << endl;
 
+    // The message above is for humans; this hands the same observation to the scoreboard, which checks it.
+    if (scoreboard != NULL) {
+        scoreboard->post_lock(base_addr / PLL_ADDR_WINDOW, sc_time_to_ps(sc_time_stamp()), period_ns);
+    }
 
+    // The output clock now runs at the new period (and starts, if this is the first lock since enable).
+    out_period_ps = period_ns * 1000.0;
+    if (jitter != NULL) {
+        jitter->set_period_ps(out_period_ps);
+    }
+    clk_out_event.notify(SC_ZERO_TIME);
+    update_clock_domain(true);
+}
 
-                // This line calculates the period of the output clock in nanoseconds (Period = 1 / Frequency).
-                double period_ns = 1000.0 / f_out_mhz; // (1000.0 because F is in MHz)
 
 
-                // This final 'cout' statement prints a rich, self-verifying message. Instead of just saying "Locked", it says "Locked"
-                // AND it reports the period of the clock it is now generating. This allows a human reading the log to instantly
-                // confirm that the PLL locked to the CORRECT frequency, not just an arbitrary one.
-                cout << "@" << sc_time_stamp() << ": PLL LOCKED. Generating output clock with period " << period_ns << " ns." << endl;
-            }
-        }
+// What is it: Tells the clock domain, if any, the current output period (stopped while there is none, or while a degenerate divider
+//             setting makes it infinite) and whether the PLL is in lock.
+void pll::update_clock_domain(bool in_lock) {
+    if (clock_domain != NULL) {
+        clock_domain->set_clock(std::isfinite(out_period_ps) ? out_period_ps : 0.0, in_lock, sc_time_to_ps(sc_time_stamp()));
     }
 }
 
 
 
 
+//================================================================================================================================
+// Process 3: Interrupt Output Logic (`SC_METHOD`)
+//================================================================================================================================
+// What is it: This is the function definition for the 'irq_process' member function of the 'pll' class.
+// Role in the project:
+// It models the tiny piece of combinational logic that sits between the interrupt registers and the `irq` pin: the pin is high if any
+// status bit is set AND enabled. Both the bus interface and the locking logic change the registers, but only this process writes the
+// pin, which keeps the signal single-driver.
+void pll::irq_process() {
+    irq.write((irq_status & irq_enable) != 0);
+}
+
+
+
+
+//================================================================================================================================
+// Process 4: Output Clock Generation (`SC_METHOD`)
+//================================================================================================================================
+// What is it: This is the function definition for the 'clk_out_process' member function of the 'pll' class.
+// Role in the project:
+// It toggles the `clk_out` pin at the locked output frequency: high for the first half of each period, low for the second. With a jitter
+// source attached, each period is the nominal one plus the next sample from the source. Edge times are accumulated in double-precision
+// picoseconds and only rounded to the 1 ps time resolution when scheduled, so the rounding never accumulates into a frequency error.
+//
+// How it works: Every activation is one edge. A falling edge ends the high half of the period and schedules the next rising edge. A
+//               rising edge (or the activation that starts the clock) first checks whether there is still a clock to generate: if not,
+//               the pin stays low and the method waits for `clk_out_event`. Like the thread it replaces, it only looks at a new period
+//               at the next rising edge, so a relock never produces a short pulse.
+void pll::clk_out_process() {
+
+    uint64_t now_ps = sc_time_to_ps(sc_time_stamp());
+
+    if (clk_out_high) {
+        clk_out.write(false);
+        clk_out_high     = false;
+        clk_out_edge_ps += clk_out_cycle_ps;
+        uint64_t rise_ps = static_cast<uint64_t>(clk_out_edge_ps + 0.5);
+        next_trigger(sc_time(static_cast<double>(rise_ps > now_ps ? rise_ps - now_ps : 1), SC_PS));
+        return;
+    }
+
+    // No locked frequency (or the pin is switched off): hold the pin low until `locking_process` says otherwise.
+    if (!clk_out_enable || !(out_period_ps > 0.0) || !std::isfinite(out_period_ps)) {
+        clk_out.write(false);
+        clk_out_running = false;
+        next_trigger(clk_out_event);
+        return;
+    }
+
+    if (!clk_out_running) {
+        clk_out_edge_ps = static_cast<double>(now_ps);
+        clk_out_running = true;
+    }
+
+    // A period can never be shorter than two time steps, however large the jitter, or the two edges would coincide.
+    clk_out_cycle_ps = out_period_ps + (jitter != NULL ? jitter->next() : 0.0);
+    if (clk_out_cycle_ps < 2.0) clk_out_cycle_ps = 2.0;
+
+    clk_out.write(true);
+    clk_out_high = true;
+    uint64_t fall_ps = static_cast<uint64_t>(clk_out_edge_ps + clk_out_cycle_ps / 2.0 + 0.5);
+    next_trigger(sc_time(static_cast<double>(fall_ps > now_ps ? fall_ps - now_ps : 1), SC_PS));
+}
+
+
+
+
 //================================================================================================================================
 //================================================================================================================================
 //
@@ -367,16 +669,18 @@ void pll::locking_process() {
 //       - What is it: SystemC's way of modeling parallel hardware operations. I implemented two concurrent processes.
 //       - `bus_process` (SC_METHOD): Models reactive, zero-time logic. It's like a block of combinational logic in Verilog that instantly
 //         responds to changes on its inputs (the clock edge). It cannot contain timed `wait()` statements.
-//       - `locking_process` (SC_THREAD): Models sequential, stateful, and time-consuming processes. It's like a state machine that can
-//         be suspended and resumed. Its ability to use `wait(time)` is essential for performance modeling.
-//       - Why is it used: Using both demonstrates an understanding of choosing the right tool for the job. The bus interface should be fast
-//         and reactive (SC_METHOD), while the physical locking behavior is slow and stateful (SC_THREAD).
+//       - `locking_process` (SC_METHOD with `next_trigger`): Models a sequential, stateful, and time-consuming process. It started out as
+//         an SC_THREAD, which can be suspended and resumed with `wait(time)`; it is now a method that sets its next activation with
+//         `next_trigger(time)` and keeps its state in members, because a thread's coroutine stack per PLL does not scale to large systems.
+//         `clk_out_process` follows the same pattern for the output clock edges, so no process of a `pll` needs a stack.
+//       - Why is it used: Choosing the right tool for the job. The bus interface is fast and reactive; the physical locking behavior is slow
+//         and stateful, and a thread is the most natural way to write it, but not the cheapest one to run thousands of times.
 //
 //   3.  Finite State Machine (FSM) Concept:
 //       - What is it: A model of computation based on a finite number of states. A machine can only be in one state at a time and transitions
 //         between states based on inputs.
-//       - Where is it used: The `locking_process` implements a simple FSM. Its states could be described as: IDLE (suspended in `wait()`),
-//         LOCKING (executing the 500ns `wait()`), and LOCKED (after `locked.write(true)`). The `pll_enable` flag and `reset` signal are
+//       - Where is it used: The `locking_process` implements a simple FSM. Its states could be described as: IDLE (waiting on its static
+//         sensitivity), LOCKING (`lock_timer_armed`, the 500ns `next_trigger()`), and LOCKED (after `locked.write(true)`). The `pll_enable` flag and `reset` signal are
 //         the inputs that cause state transitions.
 //
 //   4.  Event-Driven Synchronization:
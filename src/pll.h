@@ -78,6 +78,88 @@
 // Defines the address for the main control register, which is used to enable or disable the PLL's locking sequence.
 #define PLL_REG_CTRL_ADDR 0x0C
 
+// Defines the address for the interrupt status register. Each bit latches one interrupt cause (see `PLL_IRQ_*` below). The register
+// is "write-1-to-clear" (W1C): writing a '1' to a bit position clears that bit, writing a '0' leaves it untouched. This is the
+// standard way a driver acknowledges an interrupt without a read-modify-write race against new hardware events.
+#define PLL_REG_IRQ_STATUS_ADDR 0x10
+
+// Defines the address for the interrupt enable (mask) register. The `irq` output pin is the OR of all status bits that are also
+// enabled here. It resets to "lock-done enabled" so that an unmodified test sequence gets an interrupt for free.
+#define PLL_REG_IRQ_ENABLE_ADDR 0x14
+
+// Defines the address for the fractional part of the feedback divider, in units of 2^-24 (`PLL_FRAC_BITS`). 0 is integer-N; any other
+// value makes the PLL fractional-N, dividing by M + FRAC / 2^24 on average (`pll_sigma_delta.h`). Like N and OD, it takes effect at the
+// next lock.
+#define PLL_REG_FRAC_ADDR 0x18
+
+// The width of the FRAC register, and the value of one whole step of M in FRAC units.
+#define PLL_FRAC_BITS     24
+#define PLL_FRAC_ONE      (1u << PLL_FRAC_BITS)
+
+
+
+// What is it: Bit definitions for the interrupt status/enable registers.
+// Purpose: `PLL_IRQ_LOCK_DONE` is latched by the `locking_process` at the exact moment it drives `locked` high. The PMU can then wait
+//          on the interrupt line instead of polling (or timing out on) every PLL's `locked` output one at a time.
+#define PLL_IRQ_LOCK_DONE 0x1
+
+
+
+// What is it: The frequency of the reference clock feeding the PLL, in MHz. The output frequency is F_out = F_ref * M / (N * OD).
+// Purpose: Both the PLL model (for its lock message) and anything that has to *choose* dividers for a target frequency need this number,
+//          so it lives in the datasheet next to the register map instead of being repeated as a local constant.
+#define PLL_F_REF_MHZ     25.0
+
+
+
+// What is it: The legal operating ranges of the PLL, as they would appear in the electrical characteristics table of a datasheet.
+// Purpose: The divider registers are 8 bits wide, but not every value makes a working PLL. In particular the VCO, which runs at
+//          F_ref * M / N *before* the output divider, only oscillates inside a limited band. Software that chooses dividers (the PMU's
+//          divider solver) has to respect these limits.
+#define PLL_N_MIN          1
+#define PLL_N_MAX          16
+#define PLL_M_MIN          1
+#define PLL_M_MAX          255
+#define PLL_OD_MIN         1
+#define PLL_OD_MAX         16
+#define PLL_VCO_MIN_MHZ    400.0
+#define PLL_VCO_MAX_MHZ    1600.0
+
+
+
+// What is it: Bit definitions for the control register.
+// Purpose: Bit 0 (`PLL_CTRL_ENABLE`) turns the PLL on; its 0 -> 1 transition starts the full lock sequence and writing it as 0 turns
+//          the PLL off. Bit 1 (`PLL_CTRL_DFS_EN`) selects Dynamic Frequency Scaling mode: while the PLL is locked, a write to the M
+//          register then re-targets the running loop instead of just updating a register that is only used at the next enable.
+//          Writing CTRL = 1, as the original test does, is unchanged.
+#define PLL_CTRL_ENABLE   0x1
+#define PLL_CTRL_DFS_EN   0x2
+
+
+
+// What is it: The timing parameters of the lock model, in nanoseconds.
+// Purpose:
+//   - `PLL_LOCK_TIME_NS`: The full acquisition time after the PLL is enabled. This is the 500 ns that the original model hard-coded.
+//   - `PLL_DFS_MAX_STEP`: The largest change in M (in either direction) that the loop can follow without losing lock. Larger steps in
+//                         DFS mode fall back to the full acquisition time, but still without the PLL being disabled.
+//   - `PLL_DFS_SETTLE_BASE_NS` / `PLL_DFS_SETTLE_NS_PER_STEP`: The fast relock model. The loop is already in lock, so the settling
+//                         time is a fixed overhead plus a term proportional to the size of the frequency hop. One step of M settles in
+//                         60 ns, the maximum step of 8 in 200 ns, both well below the full 500 ns.
+#define PLL_LOCK_TIME_NS            500
+#define PLL_DFS_MAX_STEP            8
+#define PLL_DFS_SETTLE_BASE_NS      40
+#define PLL_DFS_SETTLE_NS_PER_STEP  20
+
+
+
+// What is it: The size of the address window decoded by one PLL instance, and a helper macro that computes the base address of the
+//             PLL with a given index.
+// Why is it used: As soon as more than one PLL sits on the same bus, every PLL sees every write. Giving each instance its own
+//               0x100-byte window (PLL 0 at 0x000, PLL 1 at 0x100, ...) lets the `bus_process` ignore writes meant for its neighbours.
+//               The register addresses above are therefore *offsets* inside that window. For a single PLL at base 0 nothing changes.
+#define PLL_ADDR_WINDOW   0x100
+#define PLL_BASE_ADDR(i)  ((i) * PLL_ADDR_WINDOW)
+
 
 
 
@@ -104,6 +186,24 @@
 //               (ports, registers, logic) into a single, reusable software object. The `main.cpp` file will later create an *instance*
 //               (a specific object) of this `pll` class to include it in the simulation.
 
+
+
+// What is it: The states of `locking_process`, and one "slot" per register (plus "no write since reset"), as seen by functional
+//             coverage. They are defined next to the register map because they describe the PLL itself.
+enum PllLockState { PLL_STATE_OFF, PLL_STATE_ACQUIRE, PLL_STATE_RELOCK, PLL_STATE_LOCKED, PLL_STATE_COUNT };
+enum PllWriteSlot { PLL_SLOT_N, PLL_SLOT_M, PLL_SLOT_OD, PLL_SLOT_FRAC, PLL_SLOT_CTRL, PLL_SLOT_IRQ_STATUS, PLL_SLOT_IRQ_ENABLE,
+                    PLL_SLOT_NONE, PLL_SLOT_COUNT };
+
+// What is it: Forward declarations of the functional coverage collector (`pll_coverage.h`) and the scoreboard (`pll_scoreboard.h`). The
+//             PLL only stores pointers to them, and both headers need the register map from this file, so full includes would be circular.
+class PllCoverage;
+class PllScoreboard;
+struct PllAnalogParams;
+class PllJitterSource;
+class PllPowerMeter;
+class ClockDomain;
+class pll_lock_timer;
+
 SC_MODULE(pll) {
 
 
@@ -183,6 +283,24 @@ SC_MODULE(pll) {
 
 
 
+    // What is it: This declares the interrupt request output pin.
+    // Purpose: The pin is high whenever an enabled bit is set in the interrupt status register. Unlike `locked`, which is a level that
+    //          simply reflects the current state, the interrupt is *latched*: it stays high until the PMU acknowledges it by writing
+    //          the W1C status register. This is what lets one PMU service many PLLs with a single aggregated wait, because a PLL that
+    //          locked while the PMU was busy talking to another one is still flagged when the PMU gets around to scanning.
+    sc_out<bool> irq;
+
+
+
+    // What is it: The generated output clock.
+    // Purpose: Most runs only care *that* and *when* the PLL locked, and toggling a 1.25 ns clock would dominate their run time, so the
+    //          pin stays low unless the top level turns it on with `set_clock_output()`. When on, it runs at the locked output frequency
+    //          from the moment of lock until the PLL is disabled, including through a DFS relock (the hop is glitch-free). With a
+    //          jitter source attached, every period is perturbed by the next sample of that source (`pll_jitter.h`).
+    sc_out<bool> clk_out;
+
+
+
 //================================================================================================================================
 // OOP Concept: Data Encapsulation
 //================================================================================================================================
@@ -209,6 +327,9 @@ private:
 
     sc_uint<8> reg_m, reg_n, reg_od;
 
+    // What is it: The fractional part of the feedback divider (`PLL_REG_FRAC_ADDR`).
+    sc_uint<PLL_FRAC_BITS> reg_frac;
+
 
 
     // What is it: This declares a standard C++ boolean member variable named `pll_enable`.
@@ -220,6 +341,21 @@ private:
 
 
 
+    // What is it: The base address of this instance's register window (see `PLL_BASE_ADDR`). It defaults to 0 and is changed with
+    //             `set_base_address()` by the top level when several PLLs share one bus.
+    sc_uint<32> base_addr;
+
+
+
+    // What is it: The interrupt status (W1C) and interrupt enable registers.
+    // Purpose: `irq_status` is set by the `locking_process` and cleared by the `bus_process`; `irq_enable` is only written by the bus.
+    //          Neither process drives the `irq` pin directly. Instead, both notify `irq_update_event`, and the small `irq_process`
+    //          is the *only* writer of the pin. This keeps the `irq` signal single-driver, which SystemC enforces at run time.
+    sc_uint<8> irq_status, irq_enable;
+    sc_event   irq_update_event;
+
+
+
     //================================================================================================================================
     // SystemC Concept: Inter-Process Synchronization
     //================================================================================================================================
@@ -229,7 +365,7 @@ private:
     //             equivalent but is essential for creating efficient high-level models.
     // Purpose: In my design, this event serves as the primary communication channel between the fast `bus_process` and the slow
     //          `locking_process`. When the `bus_process` receives the command to enable the PLL, it will `.notify()` this event.
-    //          The `locking_process`, which is sensitive to this event, will wake up from its suspended state and begin the
+    //          The `locking_process`, which is sensitive to this event, will be activated by the kernel and begin the
     //          time-consuming lock sequence. This elegant mechanism decouples the two processes, allowing the bus interface to
     //          remain responsive while the slow analog behavior happens in the background.
 
@@ -237,6 +373,97 @@ private:
 
 
 
+    // What is it: The state shared between `bus_process` and `locking_process` for the Dynamic Frequency Scaling (DFS) fast path.
+    // Purpose:
+    //   - `dfs_enable`:        Mirrors the `PLL_CTRL_DFS_EN` bit of the control register.
+    //   - `lock_achieved`:     True while the loop is in lock. Only a locked loop can take a fast relock; while it is still acquiring,
+    //                          a new M value is simply picked up when the acquisition completes.
+    //   - `pending_lock_time`: How long the next (re)lock sequence takes. The `bus_process` computes it (full acquisition or fast relock)
+    //                          at the moment it notifies `start_locking_event`, and the `locking_process` consumes it.
+    //   - `dfs_from_m`:        The M value before the hop, kept only for the log message.
+    //   - `lock_timer_armed`:  True while `locking_process` waits for the lock time to elapse (its `next_trigger(time, event)`), i.e.
+    //                          where the former thread version was suspended in its timed `wait()`.
+    //   - `lock_timer`:        The shared lock timer (`pll_lock_timer.h`) that holds the lock deadline instead of a timed `next_trigger()`,
+    //                          or NULL. `lock_timer_id` is this PLL's id in it; `lock_deadline_due` is set, and `lock_deadline_event`
+    //                          notified, by the timer when the deadline is reached.
+    bool       dfs_enable;
+    bool       lock_achieved;
+    sc_time    pending_lock_time;
+    sc_uint<8> dfs_from_m;
+    bool       lock_timer_armed;
+    pll_lock_timer* lock_timer;
+    unsigned        lock_timer_id;
+    bool            lock_deadline_due;
+    sc_event        lock_deadline_event;
+
+
+
+    // What is it: True from the reset entry (the first activation of `bus_process` with `reset` high) to the reset exit (its activation at
+    //             the falling edge of `reset`). `bus_process` sleeps in between, so a long reset costs one activation per PLL, not one
+    //             per clock edge.
+    bool       in_reset;
+
+
+
+    // What is it: Functional coverage hooks. `coverage` is NULL unless the top level attached a collector, in which case every bus write
+    //             and every state change of `locking_process` is sampled. `cov_last_slot` remembers the previous register written (for
+    //             write-ordering coverage).
+    PllCoverage*  coverage;
+    PllWriteSlot  cov_last_slot;
+
+
+
+    // What is it: The current state of the lock state machine, and the one place that changes it. `state_to()` reports every transition
+    //             to the coverage collector and to the power meter, if attached.
+    PllLockState  lock_state;
+    void          state_to(PllLockState next);
+
+
+
+    // What is it: The power meter that accumulates this PLL's time in each state and its bus writes, or NULL if energy is not estimated.
+    PllPowerMeter* power;
+
+
+
+    // What is it: The scoreboard that every lock is reported to, or NULL if checking is off.
+    PllScoreboard* scoreboard;
+
+
+
+    // What is it: The analog parameters of this die (`pll_lock_model.h`), or NULL for the fixed `PLL_LOCK_TIME_NS` acquisition.
+    //             With parameters, a fresh enable takes the lock time the model gives for the programmed dividers, and a die whose VCO
+    //             cannot reach the target sets `lock_possible` to false and never locks.
+    const PllAnalogParams* analog;
+    bool                   lock_possible;
+
+
+
+    // What is it: The output clock generator state. `out_period_ps` is the nominal period of the locked output (0 while there is none);
+    //             `locking_process` sets it and notifies `clk_out_event`, which wakes `clk_out_process` when the clock has to start or stop.
+    //             The other fields are where `clk_out_process` is between activations: whether the clock runs, whether the pin is in the
+    //             high half of a period, the time of the current rising edge and the length of the current period (with its jitter).
+    bool             clk_out_enable;
+    PllJitterSource* jitter;
+    double           out_period_ps;
+    sc_event         clk_out_event;
+    bool             clk_out_running;
+    bool             clk_out_high;
+    double           clk_out_edge_ps;
+    double           clk_out_cycle_ps;
+
+
+
+    // What is it: The clock domain this PLL clocks (`clock_domain.h`), or NULL. `update_clock_domain()` hands it the output period and
+    //             the lock state whenever `locking_process` changes either, so consumers follow the frequency without the `clk_out` pin.
+    //             A disable or a reset stops it, also in the middle of a relock, when the output clock was still running.
+    ClockDomain*     clock_domain;
+    void             update_clock_domain(bool in_lock);
+
+    // What is it: The time of the last `locking_process` activation, see `last_lock_activation_ps()`.
+    uint64_t         last_activation_ps;
+
+
+
      // What is it: These lines declare two private member functions of the `pll` class. In C++, a member function (or method)
     //             defines a behavior or operation that an object of the class can perform. These are just the declarations; the
     //             actual implementation (the code that defines what they do) is located in the corresponding `pll.cpp` file.
@@ -248,8 +475,19 @@ private:
     void bus_process();
 
 
-    // This declares the function that will model the stateful, time-consuming analog locking behavior. It will be registered as an `SC_THREAD`.
+    // This declares the function that will model the stateful, time-consuming analog locking behavior. It will be registered as an
+    // `SC_METHOD` that takes time with `next_trigger()`; `complete_lock()` is its lock-time-elapsed step.
     void locking_process();
+    void complete_lock();
+
+
+    // This declares the function that drives the `irq` output pin from the status and enable registers. It is an `SC_METHOD`.
+    void irq_process();
+
+
+    // This declares the function that toggles the `clk_out` pin while the PLL is locked. It is an `SC_METHOD` that takes time with
+    // `next_trigger()`, like `locking_process`.
+    void clk_out_process();
 
 
 
@@ -259,6 +497,79 @@ public:
 
 
 
+    // What is it: A public setter for the base address of this PLL's register window.
+    // Why is it used: `SC_CTOR` only accepts the instance name, so the address is configured after construction, during elaboration,
+    //               by whoever builds the system (`main.cpp`). It must be called before `sc_start()`.
+    void set_base_address(sc_uint<32> base) { base_addr = base; }
+
+
+
+    // What is it: Attaches a functional coverage collector. One collector is normally shared by all PLLs in the system.
+    void set_coverage(PllCoverage* cov) { coverage = cov; }
+
+
+
+    // What is it: Attaches the scoreboard that checks this PLL's locks against the reference model.
+    void set_scoreboard(PllScoreboard* sb) { scoreboard = sb; }
+
+
+
+    // What is it: Gives this PLL the analog parameters of a particular die, for the Monte Carlo spot-checks. The parameters are not
+    //             copied and must outlive the simulation.
+    void set_analog_params(const PllAnalogParams* params) { analog = params; }
+
+
+
+    // What is it: Turns the `clk_out` pin on, and optionally attaches the jitter source that perturbs its periods (NULL for an ideal
+    //             clock). The source is not owned by the PLL. Both must be set before `sc_start()`.
+    void set_clock_output(bool on)             { clk_out_enable = on; }
+    void set_jitter(PllJitterSource* source)   { jitter = source; }
+
+
+
+    // What is it: Attaches the power meter of this PLL (`pll_power.h`). Each PLL needs its own; it is not owned by the PLL.
+    void set_power_meter(PllPowerMeter* meter) { power = meter; }
+
+
+
+    // What is it: Attaches the clock domain this PLL is the source of (`clock_domain.h`). It is not owned by the PLL.
+    void set_clock_domain(ClockDomain* domain) { clock_domain = domain; }
+
+
+
+    // What is it: Hands the lock deadlines of this PLL to the shared lock timer, as its timer 'id' (`pll_lock_timer::attach()` calls it).
+    //             `lock_deadline_reached()` is how the timer wakes the PLL when its deadline has come.
+    void set_lock_timer(pll_lock_timer* timer, unsigned id) { lock_timer = timer; lock_timer_id = id; }
+    void lock_deadline_reached()                            { lock_deadline_due = true; lock_deadline_event.notify(); }
+
+
+
+    // What is it: The divider registers, and the output frequency of the current lock (0 unless locked). Read by the top level after the
+    //             run for the results file (`pll_results.h`).
+    int    divider_n()  const { return reg_n; }
+    int    divider_m()  const { return reg_m; }
+    int    divider_od() const { return reg_od; }
+    uint32_t divider_frac() const { return reg_frac; }
+    double locked_mhz() const { return lock_state == PLL_STATE_LOCKED && out_period_ps > 0.0 ? 1e6 / out_period_ps : 0.0; }
+
+    // What is it: The state of the lock state machine, and whether the output clock has a period (the `clk_out` pin toggles, if it is
+    //             switched on). Read by the top level after the reset scenario, which expects every PLL off.
+    PllLockState state() const         { return lock_state; }
+    bool         output_running() const { return out_period_ps > 0.0; }
+
+    // What is it: When `locking_process` last ran, in ps. Read by the top level after the domain reset scenario: the PLLs of the other
+    //             domains must not have been woken since the domain reset.
+    uint64_t     last_lock_activation_ps() const { return last_activation_ps; }
+
+
+
+    // What is it: A class-wide switch for the per-event log messages ("PLL received write ...", "PLL LOCKED ...").
+    // Why is it used: Those messages are the best debugging aid for a single directed test, but a trace replay with millions of requests
+    //               would spend nearly all of its time formatting text. `static` means one flag shared by every `pll` instance.
+    static bool verbose;
+
+
+
 
     //================================================================================================================================
     // SystemC Concept: The Constructor (`SC_CTOR`)
@@ -278,8 +589,12 @@ public:
 
 
         // This is a simple C++ `cout` statement that prints a message to the console when the constructor is called. It's a useful
-        // debugging technique to confirm that the module instance has been successfully created by the simulator.
-        cout << "PLL module constructed." << endl;
+        // debugging technique to confirm that the module instance has been successfully created by the simulator. It is one line per
+        // instance, so `--quiet` (which clears `verbose` before anything is constructed) turns it off: with ten thousand PLLs the
+        // elaboration would otherwise be timed mostly as terminal output.
+        if (verbose) {
+            cout << "PLL module constructed." << endl;
+        }
 
 
         //================================================================================================================================
@@ -295,6 +610,42 @@ public:
 
         pll_enable = false;
 
+        // The DFS state starts "off and unlocked", and the first lock sequence is always a full acquisition.
+        dfs_enable        = false;
+        lock_achieved     = false;
+        pending_lock_time = sc_time(PLL_LOCK_TIME_NS, SC_NS);
+        dfs_from_m        = 0;
+        lock_timer_armed  = false;
+        lock_timer        = NULL;
+        lock_timer_id     = 0;
+        lock_deadline_due = false;
+        in_reset          = false;
+
+        // No coverage collector until the top level attaches one.
+        coverage      = NULL;
+        lock_state    = PLL_STATE_OFF;
+        power         = NULL;
+        cov_last_slot = PLL_SLOT_NONE;
+        scoreboard    = NULL;
+        analog        = NULL;
+        lock_possible = true;
+
+        // The output clock is off until the top level turns it on, and there is no locked frequency yet.
+        clk_out_enable = false;
+        jitter         = NULL;
+        out_period_ps  = 0.0;
+        clock_domain   = NULL;
+        clk_out_running  = false;
+        clk_out_high     = false;
+        clk_out_edge_ps  = 0.0;
+        clk_out_cycle_ps = 0.0;
+        last_activation_ps = 0;
+
+        // The same reasoning applies to the new address window and interrupt registers. The lock-done interrupt is enabled out of reset.
+        base_addr  = 0;
+        irq_status = 0;
+        irq_enable = PLL_IRQ_LOCK_DONE;
+
 
 
         //================================================================================================================================
@@ -325,55 +676,67 @@ public:
         //   - `<< clk.pos()`: This makes the `bus_process` sensitive to the *positive edge* (a transition from 0 to 1) of the signal
         //                    connected to the `clk` port. This is the standard way to model synchronous digital logic that only
         //                    updates its state on a rising clock edge.
-        //   - `<< reset`: This makes the `bus_process` sensitive to *any change* on the signal connected to the `reset` port. This is
-        //                important for modeling an asynchronous reset behavior at the process level. Even though my reset logic inside
-        //                the process is synchronous (checked on a clock edge), making the process itself sensitive to any change on
-        //                `reset` ensures it wakes up promptly to evaluate the reset condition.
+        //   - `<< reset.pos()`: This makes the `bus_process` sensitive to the *assertion* of the reset, so that it enters reset promptly
+        //                      even between clock edges. It is not sensitive to the deassertion: while in reset, the process does not
+        //                      wait for the static list at all but for `reset.negedge_event()` alone (see `bus_process` in `pll.cpp`),
+        //                      so the registers are cleared once per reset and not again on every clock edge it is held for.
         // Why is it used: The sensitivity list is fundamental to event-driven simulation. It prevents the simulator from having to
         //               re-evaluate every process at every time step. Instead, a process only consumes CPU resources when one of its
         //               specific trigger events occurs, making the simulation highly efficient.
-        sensitive << clk.pos() << reset;
+        sensitive << clk.pos() << reset.pos();
 
 
 
 
 
         //================================================================================================================================
-        // SystemC Concept: Process Registration (`SC_THREAD`)
+        // SystemC Concept: Process Registration (`SC_METHOD` with `next_trigger`)
         //================================================================================================================================
-        // What is it: This line registers the `locking_process` member function with the SystemC kernel as an `SC_THREAD` process.
-        // What is an SC_THREAD: An `SC_THREAD` is another type of SystemC process, used to model sequential or stateful logic that
-        //                      takes a non-zero amount of simulation time to complete. Its key characteristics are:
-        //                        - It can be suspended and resumed using `wait()` statements. This is its most important feature.
-        //                        - It typically runs within an infinite loop (`while(true)`) to model hardware that is "always on".
-        // Why is it used here: I chose `SC_THREAD` for the `locking_process` because it is the only process type that can model the
-        //                    passage of time. The physical, analog behavior of a PLL achieving lock is not instantaneous; it takes a
-        //                    specific duration (e.g., 500 nanoseconds). An `SC_THREAD` allows me to use a timed `wait(500, SC_NS)`
-        //                    statement to accurately model this real-world performance characteristic, which is essential for any
-        //                    meaningful system-level performance analysis. An `SC_METHOD` cannot do this.
-        SC_THREAD(locking_process);
+        // What is it: This line registers the `locking_process` member function with the SystemC kernel as an `SC_METHOD` process.
+        // Why not an SC_THREAD: The lock sequence takes time (e.g., 500 nanoseconds), which is the classic job of an `SC_THREAD` and its
+        //                      `wait(500, SC_NS)`. But a thread is a coroutine: every instance owns a stack of its own (tens of kB, plus
+        //                      the guard pages), and every wake is a context switch. A system with hundreds or thousands of PLLs
+        //                      would spend most of its memory on those stacks. An `SC_METHOD` has no stack; it models the passage of
+        //                      time with `next_trigger(time, event)`, which sets the condition for its next activation, and keeps the
+        //                      little state it needs between activations in member variables (see `locking_process` in `pll.cpp`).
+        SC_METHOD(locking_process);
 
 
 
 
         //================================================================================================================================
-        // SystemC Concept: The Sensitivity List (for SC_THREAD)
+        // SystemC Concept: The Static Sensitivity List (for the locking method)
         //================================================================================================================================
-        // What is it: This line defines the sensitivity list for the `locking_process` thread. Similar to the `SC_METHOD`, this tells
-        //             the SystemC kernel which events should wake up this process from a suspended state.
-        // How it works: Inside the `locking_process` function (in `pll.cpp`), there is a `wait()` statement inside an infinite loop.
-        //               The process will pause at that `wait()` statement indefinitely until one of the events specified here occurs.
+        // What is it: This line defines the static sensitivity list for the `locking_process` method: the events that start an
+        //             activation whenever it has not called `next_trigger()` for something else.
         // Breakdown of this specific list:
-        //   - `<< reset`: This makes the `locking_process` sensitive to *any change* on the reset signal. This is critical for modeling
-        //                a high-priority, asynchronous reset. If the reset signal is asserted at any time, even while the process is in
-        //                the middle of its timed 500ns wait, this sensitivity ensures the process can be "woken up" to handle the reset
-        //                condition immediately.
+        //   - `<< reset.pos()`: This makes the `locking_process` sensitive to the assertion of the reset signal. This is critical for
+        //                      modeling a high-priority, asynchronous reset. If the reset signal is asserted while the PLL is idle or
+        //                      locked, this sensitivity ensures the process runs immediately and drops the lock. The deassertion has
+        //                      nothing to do: the reset has cleared `pll_enable`, so the PLL stays off until the next command.
         //   - `<< start_locking_event`: This makes the process sensitive to the notification of our custom `sc_event`. This is the
         //                             primary trigger for the normal operation. When the `bus_process` notifies this event, the
-        //                             `locking_process` will wake up from its `wait()` statement and begin the locking sequence.
-        // Why is it used: This sensitivity list defines the specific triggers that can start or interrupt the `locking_process`. It
-        //               ensures the process is responsive to both normal control flow (the event) and high-priority interrupts (the reset).
-        sensitive << reset << start_locking_event;
+        //                             `locking_process` runs and begins the locking sequence.
+        // `dont_initialize()`: A method normally runs once at time zero. The thread version only reached its first `wait()` there, without
+        //                    any effect, so the method skips that activation.
+        sensitive << reset.pos() << start_locking_event;
+        dont_initialize();
+
+
+
+        // What is it: This registers the `irq_process` as an `SC_METHOD` that only runs when `irq_update_event` is notified.
+        // Why is it used: The interrupt pin is pure combinational logic (`status & enable`), so a zero-time method is the right process
+        //               type. It also runs once at time zero (no `dont_initialize()`), which drives the pin to a defined low level.
+        SC_METHOD(irq_process);
+        sensitive << irq_update_event;
+
+
+
+        // What is it: This registers the `clk_out_process` as an `SC_METHOD`, for the same reason as `locking_process`: a thread would
+        //             give every PLL a coroutine stack, even with the pin switched off (the default). It has no static sensitivity: it
+        //             triggers on `clk_out_event` while there is no clock to generate, and on its own edge times while there is. The
+        //             activation at time zero drives the pin low.
+        SC_METHOD(clk_out_process);
     }
     
 };// The closing curly brace for the class definition will be at the end of the file.
@@ -0,0 +1,409 @@
+//
+// File: pll_bank.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements `pll_bank` and its differential check `pll_bank_compare` (see `pll_bank.h`). Every step of the lock sequence is
+// the one of `pll::bus_process` / `pll::locking_process` / `pll::complete_lock` (`pll.cpp`), applied to PLL `i` of the bank; the comments
+// there explain the behavior, the comments here only what is different about doing it for N PLLs at once.
+//
+
+#include "pll_bank.h"
+
+#include "pll_timer_wheel.h"
+#include "pll_coverage.h"
+#include "pll_scoreboard.h"
+#include "pll_time.h"
+#include "pll_lock_model.h"
+#include "pll_power.h"
+#include "clock_domain.h"
+
+#include <cmath>
+
+
+
+// A `command_delta` entry for a PLL with no command pending.
+#define PLL_BANK_NO_COMMAND  UINT64_MAX
+
+
+
+pll_bank::pll_bank(sc_module_name name, unsigned num_plls, sc_uint<32> base)
+    : sc_module(name), locked("locked", num_plls), irq("irq", num_plls), num(num_plls), base_addr(base), in_reset(false),
+      reg_n(num_plls, 0), reg_m(num_plls, 0), reg_od(num_plls, 0), dfs_from_m(num_plls, 0), reg_frac(num_plls, 0),
+      irq_status(num_plls, 0), irq_enable(num_plls, PLL_IRQ_LOCK_DONE),
+      enable(num_plls, 0), dfs_enable(num_plls, 0), lock_achieved(num_plls, 0), lock_possible(num_plls, 1),
+      lock_state(num_plls, PLL_STATE_OFF), wait_state(num_plls, WAIT_IDLE), cov_last_slot(num_plls, PLL_SLOT_NONE),
+      pending_lock_time(num_plls, sc_time(PLL_LOCK_TIME_NS, SC_NS)), out_period_ps(num_plls, 0.0),
+      command_delta(num_plls, PLL_BANK_NO_COMMAND), irq_pending(num_plls, 0), wheel(num_plls),
+      coverage(NULL), scoreboard(NULL), analog(NULL), power(NULL), clock_domains(NULL) {
+
+    if (pll::verbose) {
+        cout << "PLL bank of " << num_plls << " PLLs constructed." << endl;
+    }
+
+    // Like `irq_process` of every `pll`, the first activation at time zero drives every interrupt pin to a defined level.
+    for (unsigned i = 0; i < num; ++i) {
+        post_irq(i);
+    }
+
+    SC_METHOD(bus_process);
+    sensitive << clk.pos() << reset.pos();
+
+    // The sensitivity of `locking_process` while idle: a command, or the assertion of reset.
+    SC_METHOD(command_process);
+    sensitive << command_event << reset.pos();
+    dont_initialize();
+
+    SC_METHOD(timer_process);
+    sensitive << timer_event;
+    dont_initialize();
+
+    SC_METHOD(irq_process);
+    sensitive << irq_event;
+}
+
+
+
+// What is it: A command for PLL 'i' (`start_locking_event.notify(SC_ZERO_TIME)` on a `pll`). `command_process` runs its sequence in the
+//             next delta cycle. The delta count stamps the command, so that a command posted in a delta cycle where `command_process`
+//             happens to run as well (a reset assertion) is still left for the next one, as the event would be.
+void pll_bank::post_command(unsigned i) {
+    uint64_t now = sc_delta_count();
+    if (command_delta[i] != now) {
+        command_delta[i] = now;
+        commands.push_back(i);
+    }
+    command_event.notify(SC_ZERO_TIME);
+}
+
+
+
+// What is it: The interrupt pin of PLL 'i' has to be re-evaluated (`irq_update_event.notify(SC_ZERO_TIME)` on a `pll`).
+void pll_bank::post_irq(unsigned i) {
+    if (!irq_pending[i]) {
+        irq_pending[i] = 1;
+        irq_dirty.push_back(i);
+    }
+    irq_event.notify(SC_ZERO_TIME);
+}
+
+
+
+void pll_bank::state_to(unsigned i, PllLockState next) {
+    if (coverage != NULL) {
+        coverage->sample_state(PllLockState(lock_state[i]), next);
+    }
+    if (power != NULL) {
+        double out_mhz = 0.0;
+        if (next == PLL_STATE_LOCKED && reg_n[i] != 0 && reg_od[i] != 0) {
+            out_mhz = (PLL_F_REF_MHZ * (reg_m[i] + double(reg_frac[i]) / PLL_FRAC_ONE)) / (reg_n[i] * reg_od[i]);
+        }
+        power[i].transition(next, out_mhz, sc_time_to_ps(sc_time_stamp()));
+    }
+    lock_state[i] = next;
+}
+
+
+
+// What is it: The register decoder of all PLLs. A write is decoded once: the window selects the PLL by index, the offset the register.
+//             A write outside the bank's windows is ignored. On the reset entry, every PLL's registers are cleared and every PLL gets a
+//             command, as every `pll` would (a lock wait ends at the reset), and the process sleeps until the reset is released (see
+//             `pll::bus_process`).
+void pll_bank::bus_process() {
+
+    if (reset.read() == true) {
+        for (unsigned i = 0; i < num; ++i) {
+            reg_m[i] = 0; reg_n[i] = 0; reg_od[i] = 0; reg_frac[i] = 0; enable[i] = 0; dfs_enable[i] = 0;
+            irq_status[i] = 0; irq_enable[i] = PLL_IRQ_LOCK_DONE;
+            cov_last_slot[i] = PLL_SLOT_NONE;
+            post_irq(i);
+            post_command(i);
+        }
+        in_reset = true;
+        next_trigger(reset.negedge_event());
+        return;
+    }
+
+    // The reset exit: the falling edge of reset is not a bus cycle.
+    if (in_reset) {
+        in_reset = false;
+        return;
+    }
+
+    if (bus_we.read() != true) {
+        return;
+    }
+
+    sc_uint<32> addr   = bus_addr.read();
+    sc_uint<32> window = addr & ~sc_uint<32>(PLL_ADDR_WINDOW - 1);
+    if (window < base_addr || (window - base_addr) / PLL_ADDR_WINDOW >= num) {
+        return;
+    }
+    unsigned    i      = (window - base_addr) / PLL_ADDR_WINDOW;
+    sc_uint<32> offset = addr & (PLL_ADDR_WINDOW - 1);
+    uint32_t    data   = bus_wdata.read().to_uint();
+
+    switch (offset) {
+        case PLL_REG_N_ADDR:  reg_n[i] = uint8_t(data); break;
+
+        case PLL_REG_M_ADDR: {
+            uint8_t new_m = uint8_t(data);
+            if (enable[i] && dfs_enable[i] && lock_achieved[i] && new_m != reg_m[i]) {
+                int step = (new_m > reg_m[i]) ? int(new_m - reg_m[i]) : int(reg_m[i] - new_m);
+                if (step <= PLL_DFS_MAX_STEP) {
+                    pending_lock_time[i] = sc_time(PLL_DFS_SETTLE_BASE_NS + PLL_DFS_SETTLE_NS_PER_STEP * step, SC_NS);
+                } else {
+                    pending_lock_time[i] = sc_time(PLL_LOCK_TIME_NS, SC_NS);
+                }
+                dfs_from_m[i] = reg_m[i];
+                post_command(i);
+            }
+            reg_m[i] = new_m;
+            break;
+        }
+
+        case PLL_REG_OD_ADDR: reg_od[i] = uint8_t(data); break;
+
+        case PLL_REG_FRAC_ADDR: reg_frac[i] = data & (PLL_FRAC_ONE - 1); break;
+
+        case PLL_REG_CTRL_ADDR:
+            dfs_enable[i] = (data & PLL_CTRL_DFS_EN) != 0;
+            if ((data & PLL_CTRL_ENABLE) != 0) {
+                if (!enable[i]) {
+                    enable[i]            = 1;
+                    pending_lock_time[i] = sc_time(PLL_LOCK_TIME_NS, SC_NS);
+                    lock_possible[i]     = 1;
+                    if (analog != NULL) {
+                        PllConfig cfg = { int(reg_m[i]), int(reg_n[i]), int(reg_od[i]) };
+                        PllLockResult r = pll_lock_model(analog[i], cfg);
+                        pending_lock_time[i] = sc_time(r.lock_ns, SC_NS);
+                        lock_possible[i]     = r.locks;
+                    }
+                    post_command(i);
+                }
+            } else {
+                enable[i] = 0;
+                post_command(i);
+            }
+            break;
+
+        case PLL_REG_IRQ_STATUS_ADDR:
+            irq_status[i] = uint8_t(irq_status[i] & ~data);
+            post_irq(i);
+            break;
+
+        case PLL_REG_IRQ_ENABLE_ADDR:
+            irq_enable[i] = uint8_t(data);
+            post_irq(i);
+            break;
+    }
+
+    if (coverage != NULL) {
+        cov_last_slot[i] = coverage->sample_write(offset, data, PllWriteSlot(cov_last_slot[i]));
+    }
+    if (power != NULL) {
+        power[i].bus_write();
+    }
+
+    if (pll::verbose) cout << "@" << sc_time_stamp() << ": PLL_BANK[" << i << "] received write to REG[" << offset / 4 << "] with data 0x"
+                           << hex << data << dec << endl;
+}
+
+
+
+// What is it: Runs the lock sequence of every PLL that has a command from the previous delta cycle and, on a reset assertion, of every
+//             PLL that is idle (a `pll` in that state is woken by its static sensitivity to `reset.pos()`). A reset is rare; commands are
+//             the common case and cost nothing for the PLLs that did not get one.
+void pll_bank::command_process() {
+
+    uint64_t now = sc_delta_count();
+
+    if (reset.posedge()) {
+        for (unsigned i = 0; i < num; ++i) {
+            if (wait_state[i] == WAIT_IDLE && (command_delta[i] == PLL_BANK_NO_COMMAND || command_delta[i] == now)) {
+                start_lock(i);
+            }
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t k = 0; k < commands.size(); ++k) {
+        unsigned i = commands[k];
+        if (command_delta[i] == now) {
+            commands[kept++] = i;      // Posted in this delta cycle: runs in the next one
+        } else if (command_delta[i] != PLL_BANK_NO_COMMAND) {
+            command_delta[i] = PLL_BANK_NO_COMMAND;
+            start_lock(i);
+        }
+    }
+    commands.resize(kept);
+
+    arm_timer();
+}
+
+
+
+// What is it: One activation of `pll::locking_process` for PLL 'i' outside its lock-time-elapsed step. A pending lock deadline of the PLL
+//             is cancelled first (the event half of the `next_trigger(lock_time, start_locking_event)` of a `pll`).
+void pll_bank::start_lock(unsigned i) {
+
+    wheel.cancel(i);
+    wait_state[i] = WAIT_IDLE;
+
+    if (reset.read() == true || !enable[i]) {
+        locked[i].write(false);
+        lock_achieved[i] = 0;
+        if (lock_state[i] != PLL_STATE_OFF) state_to(i, PLL_STATE_OFF);
+        out_period_ps[i] = 0.0;
+        update_clock_domain(i, false);
+        return;
+    }
+
+    sc_time lock_time = pending_lock_time[i];
+
+    if (!pll::verbose) {
+        // Logging is switched off for long runs; nothing to print.
+    } else if (lock_achieved[i]) {
+        cout << "@" << sc_time_stamp() << ": PLL_BANK[" << i << "] DFS step M " << unsigned(dfs_from_m[i]) << " -> " << unsigned(reg_m[i])
+             << ". Fast relock, settling for " << lock_time << "." << endl;
+    } else {
+        cout << "@" << sc_time_stamp() << ": PLL_BANK[" << i << "] enabled. Waiting for " << lock_time << "." << endl;
+    }
+
+    state_to(i, lock_achieved[i] ? PLL_STATE_RELOCK : PLL_STATE_ACQUIRE);
+    if (coverage != NULL) {
+        coverage->sample_lock_start(reg_n[i], reg_m[i], reg_od[i]);
+    }
+
+    locked[i].write(false);
+    lock_achieved[i] = 0;
+    update_clock_domain(i, false);
+
+    if (!lock_possible[i]) {
+        wait_state[i] = WAIT_COMMAND;
+        return;
+    }
+
+    wait_state[i] = WAIT_LOCK;
+    wheel.schedule(i, sc_time_to_ps(sc_time_stamp()) + sc_time_to_ps(lock_time));
+}
+
+
+
+// What is it: The single timer of the bank. It advances the wheel to the current time, completes the lock of every PLL that is due now,
+//             and re-arms `timer_event` for the earliest deadline still pending.
+void pll_bank::timer_process() {
+
+    fired.clear();
+    wheel.advance(sc_time_to_ps(sc_time_stamp()), fired);
+    for (size_t k = 0; k < fired.size(); ++k) {
+        unsigned i = fired[k];
+        wait_state[i] = WAIT_IDLE;
+        if (enable[i] && reset.read() == false) {
+            complete_lock(i);
+        } else {
+            start_lock(i);      // A lock no longer wanted: switched off, as `pll::locking_process` does
+        }
+    }
+
+    arm_timer();
+}
+
+
+
+// What is it: Points `timer_event` at the earliest pending deadline, or cancels it if nothing is pending. Called whenever the set of
+//             deadlines may have changed, so the timer never wakes for a lock that was cancelled. A deadline of now is a delta
+//             notification, exactly like a zero lock time in the `next_trigger()` of a `pll`.
+void pll_bank::arm_timer() {
+    timer_event.cancel();
+    if (!wheel.empty()) {
+        uint64_t now_ps = sc_time_to_ps(sc_time_stamp());
+        timer_event.notify(sc_time(static_cast<double>(wheel.next_deadline() - now_ps), SC_PS));
+    }
+}
+
+
+
+// What is it: `pll::complete_lock` for PLL 'i'. Like there, only called for a lock that is still wanted.
+void pll_bank::complete_lock(unsigned i) {
+
+    locked[i].write(true);
+    lock_achieved[i] = 1;
+    state_to(i, PLL_STATE_LOCKED);
+
+    irq_status[i] = irq_status[i] | PLL_IRQ_LOCK_DONE;
+    post_irq(i);
+
+    double f_out_mhz = (PLL_F_REF_MHZ * (reg_m[i] + double(reg_frac[i]) / PLL_FRAC_ONE)) / (reg_n[i] * reg_od[i]);
+    double period_ns = 1000.0 / f_out_mhz;
+
+    if (pll::verbose) cout << "@" << sc_time_stamp() << ": PLL_BANK[" << i << "] LOCKED. Output clock period " << period_ns << " ns." << endl;
+
+    if (scoreboard != NULL) {
+        scoreboard->post_lock(base_addr / PLL_ADDR_WINDOW + i, sc_time_to_ps(sc_time_stamp()), period_ns);
+    }
+
+    out_period_ps[i] = period_ns * 1000.0;
+    update_clock_domain(i, true);
+}
+
+
+
+void pll_bank::update_clock_domain(unsigned i, bool in_lock) {
+    if (clock_domains != NULL && clock_domains[i] != NULL) {
+        double period_ps = std::isfinite(out_period_ps[i]) ? out_period_ps[i] : 0.0;
+        clock_domains[i]->set_clock(period_ps, in_lock, sc_time_to_ps(sc_time_stamp()));
+    }
+}
+
+
+
+// What is it: Drives the interrupt pin of every PLL whose registers changed in the previous delta cycle.
+void pll_bank::irq_process() {
+    for (size_t k = 0; k < irq_dirty.size(); ++k) {
+        unsigned i = irq_dirty[k];
+        irq_pending[i] = 0;
+        irq[i].write((irq_status[i] & irq_enable[i]) != 0);
+    }
+    irq_dirty.clear();
+}
+
+
+
+
+pll_bank_compare::pll_bank_compare(sc_module_name name, unsigned num_plls)
+    : sc_module(name), ref_locked("ref_locked", num_plls), ref_irq("ref_irq", num_plls),
+      bank_locked("bank_locked", num_plls), bank_irq("bank_irq", num_plls), num_checks(0), num_mismatches(0) {
+
+    SC_METHOD(compare_process);
+    for (unsigned i = 0; i < num_plls; ++i) {
+        sensitive << ref_locked[i] << ref_irq[i] << bank_locked[i] << bank_irq[i];
+    }
+    dont_initialize();
+}
+
+
+
+// How it works: The method runs in the delta cycle after any of the pins changed. Pins that changed together on both sides have the same
+//               value again by then; a pin that changed on one side only, or one delta cycle later, is a mismatch.
+void pll_bank_compare::compare_process() {
+
+    const uint64_t MAX_PRINTED = 10;
+
+    num_checks++;
+    for (unsigned i = 0; i < ref_locked.size(); ++i) {
+        bool locked_ok = ref_locked[i].read() == bank_locked[i].read();
+        bool irq_ok    = ref_irq[i].read() == bank_irq[i].read();
+        if (locked_ok && irq_ok) {
+            continue;
+        }
+        if (++num_mismatches <= MAX_PRINTED) {
+            cout << "BANK_CHECK: @" << sc_time_stamp() << " (delta " << sc_delta_count() << "): PLL " << i
+                 << ": pll locked " << ref_locked[i].read() << " irq " << ref_irq[i].read()
+                 << ", bank locked " << bank_locked[i].read() << " irq " << bank_irq[i].read() << endl;
+        }
+    }
+}
@@ -0,0 +1,175 @@
+//
+// File: pll_bank.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `pll_bank`, one module that models N PLLs, for systems with thousands of clock generators. It has the register
+// map, the lock state machine and the `locked` / `irq` pins of N `pll` instances at consecutive register windows, and behaves exactly
+// like them, delta cycle for delta cycle. The bank is not N modules, though:
+//
+//   - Structure of arrays: The registers, enable flags, lock states and deadlines of all PLLs are stored column by column, one vector per
+//     field, indexed by PLL. There is no module, process, event or port object per PLL beyond the two output pins.
+//   - One bus decoder: A bus write is decoded once, by index (address / window), instead of being seen and rejected by every PLL.
+//   - One timer process: Every pending lock completion is an entry in one hierarchical timer wheel (`pll_timer_wheel.h`). A single method
+//     wakes at the earliest deadline, completes every lock that is due in one pass, and sleeps until the next one. A new command for a PLL
+//     that is still locking (a DFS step, or a disable) cancels its entry in O(1).
+//
+// What it does not model: the `clk_out` pin. A system that needs the output clock of a PLL instantiates that PLL as a `pll`.
+//
+// How the timing matches `pll`: Each process of the bank does, for all PLLs, what the process of the same role does for one `pll`, in the
+// same delta cycle: `bus_process` decodes the write at the clock edge, `command_process` runs the (re)lock sequence one delta later (as
+// `locking_process` does when `start_locking_event` fires), `timer_process` completes locks at their deadline, and `irq_process` drives
+// the interrupt pins one delta after that. `pll_bank_compare` (below) checks this against N `pll` instances on the same bus.
+//
+
+#ifndef PLL_BANK_H
+#define PLL_BANK_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+#include <vector>
+
+// The register map, the timing parameters and `PllLockState`.
+#include "pll.h"
+
+// The pending lock completions.
+#include "pll_timer_wheel.h"
+
+
+
+SC_MODULE(pll_bank) {
+
+    // The shared clock, reset and bus, as on `pll`.
+    sc_in<bool>        clk;
+    sc_in<bool>        reset;
+    sc_in<sc_uint<32>> bus_addr;
+    sc_in<sc_uint<32>> bus_wdata;
+    sc_in<bool>        bus_we;
+
+    // The `locked` and `irq` pins of every PLL. Sized by the constructor.
+    sc_vector<sc_out<bool>> locked;
+    sc_vector<sc_out<bool>> irq;
+
+
+
+    // What is it: Creates a bank of 'num_plls' PLLs. PLL `i` of the bank decodes the register window at `base + PLL_BASE_ADDR(i)`.
+    pll_bank(sc_module_name name, unsigned num_plls, sc_uint<32> base = 0);
+
+    SC_HAS_PROCESS(pll_bank);
+
+
+
+    // What is it: The hooks of `pll`, for the whole bank. Coverage and the scoreboard are shared by all PLLs (the scoreboard sees PLL `i`
+    //             as PLL `base index + i`); the analog parameters and the power meters are arrays of `size()` entries, and the clock
+    //             domains an array of `size()` pointers (NULL for a PLL that clocks none), none of them owned by the bank. All must be set
+    //             before `sc_start()`.
+    void set_coverage(PllCoverage* cov)                   { coverage = cov; }
+    void set_scoreboard(PllScoreboard* sb)                { scoreboard = sb; }
+    void set_analog_params(const PllAnalogParams* params) { analog = params; }
+    void set_power_meters(PllPowerMeter* meters)          { power = meters; }
+    void set_clock_domains(ClockDomain* const* domains)   { clock_domains = domains; }
+
+
+
+    // What is it: The state of PLL 'i', as the getters of `pll` give it for one instance.
+    unsigned size() const { return num; }
+    int    divider_n(unsigned i)  const { return reg_n[i]; }
+    int    divider_m(unsigned i)  const { return reg_m[i]; }
+    int    divider_od(unsigned i) const { return reg_od[i]; }
+    uint32_t divider_frac(unsigned i) const { return reg_frac[i]; }
+    double locked_mhz(unsigned i) const { return lock_state[i] == PLL_STATE_LOCKED && out_period_ps[i] > 0.0 ? 1e6 / out_period_ps[i] : 0.0; }
+    PllLockState state(unsigned i) const   { return PllLockState(lock_state[i]); }
+    bool   output_running(unsigned i) const { return out_period_ps[i] > 0.0; }
+
+
+
+private:
+
+    // What is it: Where a PLL's lock sequence is waiting, i.e. what restarts it. These are the three ways `pll::locking_process` can
+    //             be suspended (see `pll.cpp`).
+    enum WaitState {
+        WAIT_IDLE,      // Off or locked: a command or a reset assertion
+        WAIT_COMMAND,   // A die that cannot lock, in ACQUIRE: a command only
+        WAIT_LOCK       // Locking: its deadline, or a command (a reset posts one to every PLL)
+    };
+
+    unsigned    num;
+    sc_uint<32> base_addr;
+    bool        in_reset;       // Between the reset entry and exit of `bus_process`, as on `pll`
+
+    // What is it: The per-PLL state, one vector per field. The registers are 8 bits wide, as on `pll`.
+    std::vector<uint8_t>  reg_n, reg_m, reg_od, dfs_from_m;
+    std::vector<uint32_t> reg_frac;
+    std::vector<uint8_t>  irq_status, irq_enable;
+    std::vector<uint8_t>  enable, dfs_enable, lock_achieved, lock_possible;
+    std::vector<uint8_t>  lock_state;           // PllLockState
+    std::vector<uint8_t>  wait_state;           // WaitState
+    std::vector<uint8_t>  cov_last_slot;        // PllWriteSlot
+    std::vector<sc_time>  pending_lock_time;
+    std::vector<double>   out_period_ps;
+
+    // What is it: The PLLs that received a command (`start_locking_event` of a `pll`), with the delta cycle it was posted in, and those
+    //             whose interrupt pin has to be re-evaluated (`irq_update_event`), with a flag so that a PLL is listed at most once.
+    std::vector<uint32_t> commands, irq_dirty;
+    std::vector<uint64_t> command_delta;
+    std::vector<uint8_t>  irq_pending;
+    sc_event              command_event, irq_event;
+
+    // What is it: The pending lock completions (timer id = PLL index), the event that wakes `timer_process` at the earliest of them, and
+    //             the PLLs that are due, collected by the wheel on each wake.
+    PllTimerWheel         wheel;
+    sc_event              timer_event;
+    std::vector<uint32_t> fired;
+
+    PllCoverage*           coverage;
+    PllScoreboard*         scoreboard;
+    const PllAnalogParams* analog;
+    PllPowerMeter*         power;
+    ClockDomain* const*    clock_domains;
+
+    void bus_process();
+    void command_process();
+    void timer_process();
+    void irq_process();
+
+    void start_lock(unsigned i);
+    void complete_lock(unsigned i);
+    void state_to(unsigned i, PllLockState next);
+    void update_clock_domain(unsigned i, bool in_lock);
+    void post_command(unsigned i);
+    void post_irq(unsigned i);
+    void arm_timer();
+};
+
+
+
+// What is it: The differential check of `pll_bank` against `pll`: it watches the `locked` and `irq` pins of N `pll` instances (the
+//             reference) and of a bank of N PLLs on the same bus (the model under test), and counts every delta cycle in which any
+//             pair differs. Both sides are driven by the same writes, so they must agree at every instant.
+SC_MODULE(pll_bank_compare) {
+
+    sc_vector<sc_in<bool>> ref_locked, ref_irq;
+    sc_vector<sc_in<bool>> bank_locked, bank_irq;
+
+    pll_bank_compare(sc_module_name name, unsigned num_plls);
+
+    SC_HAS_PROCESS(pll_bank_compare);
+
+    // What is it: The number of comparisons made and of mismatches found. The first few mismatches are also printed as they happen.
+    uint64_t checks() const     { return num_checks; }
+    uint64_t mismatches() const { return num_mismatches; }
+
+private:
+    uint64_t num_checks, num_mismatches;
+
+    void compare_process();
+};
+
+
+#endif // PLL_BANK_H
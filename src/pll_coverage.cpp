@@ -0,0 +1,231 @@
+//
+// File: pll_coverage.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the functional coverage collector declared in `pll_coverage.h`: the cold parts (cross sampling, reporting and
+// the save / merge file format). The per-write sampling is inline in the header.
+//
+
+#include "pll_coverage.h"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+
+
+// What is it: Counts the bins that have been hit, one 64-bit word at a time.
+// How it works: `w &= w - 1` clears the lowest set bit, so the inner loop runs once per hit bin rather than once per bin.
+unsigned CoverageBitmap::hits() const {
+    unsigned n = 0;
+    for (unsigned i = 0; i < words.size(); ++i) {
+        for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+bool CoverageBitmap::merge(const CoverageBitmap& other) {
+    if (other.num_bins != num_bins) {
+        return false;
+    }
+    for (unsigned i = 0; i < words.size(); ++i) {
+        words[i] |= other.words[i];
+    }
+    return true;
+}
+
+
+
+static const unsigned N_VALUES  = PLL_N_MAX  - PLL_N_MIN  + 1;
+static const unsigned M_VALUES  = PLL_M_MAX  - PLL_M_MIN  + 1;
+static const unsigned OD_VALUES = PLL_OD_MAX - PLL_OD_MIN + 1;
+
+PllCoverage::PllCoverage()
+    : cp_n("reg_n", N_VALUES + 1), cp_m("reg_m", M_VALUES + 1), cp_od("reg_od", OD_VALUES + 1),
+      cp_frac("reg_frac", PLL_COV_FRAC_BINS),
+      cp_ctrl("reg_ctrl", PLL_CTRL_ENABLE + PLL_CTRL_DFS_EN + 1),
+      cx_dividers("cross_n_m_od", N_VALUES * M_VALUES * OD_VALUES),
+      cx_vco_band("cross_n_od_vco_band", N_VALUES * OD_VALUES * PLL_COV_VCO_BANDS),
+      tr_write_order("trans_write_order", PLL_SLOT_COUNT * PLL_SLOT_COUNT),
+      tr_lock_fsm("trans_lock_fsm", PLL_STATE_COUNT * PLL_STATE_COUNT) {
+}
+
+
+
+// What is it: The cross coverpoints, sampled once per lock sequence.
+// How it works: A lock started with any divider out of range only counts as far as its legal parts go: an illegal N or OD makes both
+//               crosses meaningless, so nothing is recorded (the illegal value itself was already binned by `sample_write`).
+void PllCoverage::sample_lock_start(unsigned n, unsigned m, unsigned od) {
+
+    if (n < PLL_N_MIN || n > PLL_N_MAX || od < PLL_OD_MIN || od > PLL_OD_MAX) {
+        return;
+    }
+    unsigned ni  = n  - PLL_N_MIN;
+    unsigned odi = od - PLL_OD_MIN;
+
+    if (m >= PLL_M_MIN && m <= PLL_M_MAX) {
+        cx_dividers.hit((ni * M_VALUES + (m - PLL_M_MIN)) * OD_VALUES + odi);
+    }
+
+    double   vco  = PLL_F_REF_MHZ * m / n;
+    unsigned band;
+    if (vco < PLL_VCO_MIN_MHZ) {
+        band = 0;
+    } else if (vco > PLL_VCO_MAX_MHZ) {
+        band = PLL_COV_VCO_BANDS - 1;
+    } else {
+        band = 1 + static_cast<unsigned>(3.0 * (vco - PLL_VCO_MIN_MHZ) / (PLL_VCO_MAX_MHZ - PLL_VCO_MIN_MHZ));
+        if (band > 3) band = 3;   // exactly PLL_VCO_MAX_MHZ belongs to the high third
+    }
+    cx_vco_band.hit((ni * OD_VALUES + odi) * PLL_COV_VCO_BANDS + band);
+}
+
+
+
+std::vector<CoverageBitmap*> PllCoverage::all() const {
+    PllCoverage* self = const_cast<PllCoverage*>(this);
+    CoverageBitmap* cps[] = { &self->cp_n, &self->cp_m, &self->cp_od, &self->cp_frac, &self->cp_ctrl, &self->cx_dividers, &self->cx_vco_band,
+                              &self->tr_write_order, &self->tr_lock_fsm };
+    return std::vector<CoverageBitmap*>(cps, cps + sizeof(cps) / sizeof(cps[0]));
+}
+
+
+
+void PllCoverage::report(std::ostream& os) const {
+
+    static const char* slot_names[]  = { "N", "M", "OD", "FRAC", "CTRL", "IRQ_STATUS", "IRQ_ENABLE", "reset" };
+    static const char* state_names[] = { "OFF", "ACQUIRE", "RELOCK", "LOCKED" };
+
+    std::vector<CoverageBitmap*> cps = all();
+    unsigned total_hits = 0, total_bins = 0;
+
+    os << "COVERAGE:" << std::endl;
+    for (unsigned i = 0; i < cps.size(); ++i) {
+        unsigned h = cps[i]->hits();
+        total_hits += h;
+        total_bins += cps[i]->bins();
+        os << "  " << std::left << std::setw(22) << cps[i]->name() << std::right << std::setw(6) << h << " / "
+           << std::setw(6) << cps[i]->bins() << "  (" << std::fixed << std::setprecision(1)
+           << 100.0 * h / cps[i]->bins() << "%)" << std::defaultfloat << std::endl;
+    }
+    os << "  Overall: " << total_hits << " / " << total_bins << " bins." << std::endl;
+
+    // The lock state machine is small enough that its holes are worth listing by name. Transitions the design cannot make are skipped
+    // (the equivalent of SystemVerilog `ignore_bins`): OFF and LOCKED have no self-loops, a relock only starts from LOCKED, and an
+    // interrupted relock restarts as a full acquisition, so nothing enters RELOCK except from LOCKED, and OFF never goes straight to LOCKED.
+    os << "  Lock FSM transitions not yet seen:";
+    bool any = false;
+    for (unsigned from = 0; from < PLL_STATE_COUNT; ++from) {
+        for (unsigned to = 0; to < PLL_STATE_COUNT; ++to) {
+            if (from == to && from != PLL_STATE_ACQUIRE) continue;
+            if (to == PLL_STATE_RELOCK && from != PLL_STATE_LOCKED) continue;
+            if (from == PLL_STATE_OFF && to == PLL_STATE_LOCKED) continue;
+            if (!tr_lock_fsm.is_hit(from * PLL_STATE_COUNT + to)) {
+                os << " " << state_names[from] << "->" << state_names[to];
+                any = true;
+            }
+        }
+    }
+    os << (any ? "" : " none") << std::endl;
+
+    // For the write ordering only the divider / control registers are listed; the interrupt registers are written in any order. The
+    // FRAC orderings are only holes once a fractional-N run has written FRAC: an integer-N sweep never does.
+    os << "  Divider/CTRL write orderings not yet seen:";
+    any = false;
+    bool frac_written = cp_frac.hits() > 0;
+    for (unsigned from = 0; from < PLL_SLOT_COUNT; ++from) {
+        for (unsigned to = PLL_SLOT_N; to <= PLL_SLOT_CTRL; ++to) {
+            if (from == PLL_SLOT_IRQ_STATUS || from == PLL_SLOT_IRQ_ENABLE) continue;
+            if ((from == PLL_SLOT_FRAC || to == PLL_SLOT_FRAC) && !frac_written) continue;
+            if (!tr_write_order.is_hit(from * PLL_SLOT_COUNT + to)) {
+                os << " " << slot_names[from] << "->" << slot_names[to];
+                any = true;
+            }
+        }
+    }
+    os << (any ? "" : " none") << std::endl;
+}
+
+
+
+//================================================================================================================================
+// Save / Load
+//================================================================================================================================
+// One line per coverpoint: its name, its number of bins, and its bitmap as hexadecimal 64-bit words.
+//
+//     pll_coverage v1 <name> <bins> <word0> <word1> ...
+
+bool PllCoverage::save(const std::string& path) const {
+
+    std::ofstream out(path.c_str());
+    if (!out) {
+        std::cerr << "COVERAGE: Cannot write '" << path << "'." << std::endl;
+        return false;
+    }
+
+    std::vector<CoverageBitmap*> cps = all();
+    out << std::hex;
+    for (unsigned i = 0; i < cps.size(); ++i) {
+        out << "pll_coverage v1 " << cps[i]->cp_name << " " << std::dec << cps[i]->num_bins << std::hex;
+        for (unsigned w = 0; w < cps[i]->words.size(); ++w) {
+            out << " " << cps[i]->words[w];
+        }
+        out << "\n";
+    }
+
+    return static_cast<bool>(out);
+}
+
+
+
+bool PllCoverage::load(const std::string& path) {
+
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "COVERAGE: Cannot read '" << path << "'." << std::endl;
+        return false;
+    }
+
+    std::vector<CoverageBitmap*> cps = all();
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string magic, version, name;
+        unsigned bins;
+        fields >> magic >> version >> name >> bins;
+        if (!fields || magic != "pll_coverage" || version != "v1") {
+            std::cerr << "COVERAGE: '" << path << "' is not a coverage database." << std::endl;
+            return false;
+        }
+
+        CoverageBitmap saved(name, bins);
+        fields >> std::hex;
+        for (unsigned w = 0; w < saved.words.size(); ++w) {
+            fields >> saved.words[w];
+        }
+        if (!fields) {
+            std::cerr << "COVERAGE: '" << path << "': truncated coverpoint '" << name << "'." << std::endl;
+            return false;
+        }
+
+        for (unsigned i = 0; i < cps.size(); ++i) {
+            if (cps[i]->name() == name && !cps[i]->merge(saved)) {
+                std::cerr << "COVERAGE: '" << path << "': coverpoint '" << name << "' has a different layout." << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
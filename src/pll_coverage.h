@@ -0,0 +1,141 @@
+//
+// File: pll_coverage.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the functional coverage collector for the PLL. Passing tests only tell us that what we tried worked; coverage
+// tells us *what we tried*. It answers questions like "which (N, M, OD) combinations have ever been locked?", "did anyone ever write
+// the dividers after CTRL?" and "have we ever seen a DFS relock interrupted by a disable?".
+//
+// The collector is organised like a SystemVerilog covergroup, with three kinds of coverpoints:
+//   - Register values:  one bin per legal value of N, M and OD (plus one "illegal" bin each), one bin per CTRL bit pattern, and FRAC
+//                       as integer-N or the quarter its fraction is in, so a fractional-N run shows up.
+//   - Crosses:          every legal (N, M, OD) triple that started a lock, and (N, OD) crossed with the band the VCO lands in.
+//   - Transitions:      consecutive register writes to one PLL (write ordering), and the state transitions of `locking_process`.
+//
+// Every coverpoint is a dense bitmap: one bit per bin. Sampling is an index calculation and one OR into a 64-bit word, so it can sit in
+// `bus_process` on every write without showing up in a profile. Merging the databases of parallel runs is a word-wise OR.
+//
+
+#ifndef PLL_COVERAGE_H
+#define PLL_COVERAGE_H
+
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+
+// The register map and the legal ranges define the bins; `PllLockState` and `PllWriteSlot` index the transition coverpoints.
+#include "pll.h"
+
+
+
+// What is it: One coverpoint: a name and a fixed-size bitmap of bins.
+class CoverageBitmap {
+public:
+    CoverageBitmap(const std::string& name, unsigned bins)
+        : cp_name(name), num_bins(bins), words((bins + 63) / 64, 0) {}
+
+    // The hot path: mark one bin as hit. Out-of-range bins are a caller bug and are ignored rather than corrupting memory.
+    void hit(unsigned bin) {
+        if (bin < num_bins) words[bin >> 6] |= static_cast<uint64_t>(1) << (bin & 63);
+    }
+
+    bool               is_hit(unsigned bin) const { return bin < num_bins && ((words[bin >> 6] >> (bin & 63)) & 1) != 0; }
+    unsigned           hits()  const;
+    unsigned           bins()  const { return num_bins; }
+    const std::string& name()  const { return cp_name; }
+
+    // What is it: Adds another run's coverage of the same coverpoint. `false` if the layouts differ.
+    bool merge(const CoverageBitmap& other);
+
+private:
+    friend class PllCoverage;
+
+    std::string           cp_name;
+    unsigned              num_bins;
+    std::vector<uint64_t> words;
+};
+
+
+
+// The VCO frequency is classified into five bands: below the legal range, the low / middle / high third of it, and above it.
+#define PLL_COV_VCO_BANDS 5
+
+// The FRAC register is classified into five bins: 0 (integer-N), and the quarter of the unit interval the fraction falls into.
+#define PLL_COV_FRAC_BINS 5
+
+
+
+//================================================================================================================================
+// The Coverage Collector
+//================================================================================================================================
+// What is it: The covergroup for the PLL. One instance is shared by every PLL in the system (they are all sampled from the SystemC
+//             kernel thread, so no locking is needed); per-PLL sampling state such as "the previous write" lives in the PLL itself.
+
+class PllCoverage {
+public:
+    PllCoverage();
+
+    // What is it: Samples a bus write. 'prev_slot' is the slot of the previous write to the same PLL, so the write-ordering transition
+    //             can be recorded. Returns this write's slot, for the PLL to remember.
+    PllWriteSlot sample_write(unsigned offset, uint32_t data, PllWriteSlot prev_slot) {
+        PllWriteSlot slot;
+        switch (offset) {
+            case PLL_REG_N_ADDR:          slot = PLL_SLOT_N;          cp_n.hit(value_bin(data, PLL_N_MIN, PLL_N_MAX));   break;
+            case PLL_REG_M_ADDR:          slot = PLL_SLOT_M;          cp_m.hit(value_bin(data, PLL_M_MIN, PLL_M_MAX));   break;
+            case PLL_REG_OD_ADDR:         slot = PLL_SLOT_OD;         cp_od.hit(value_bin(data, PLL_OD_MIN, PLL_OD_MAX)); break;
+            case PLL_REG_FRAC_ADDR:       slot = PLL_SLOT_FRAC;       cp_frac.hit(frac_bin(data));                       break;
+            case PLL_REG_CTRL_ADDR:       slot = PLL_SLOT_CTRL;       cp_ctrl.hit(data & (PLL_CTRL_ENABLE | PLL_CTRL_DFS_EN)); break;
+            case PLL_REG_IRQ_STATUS_ADDR: slot = PLL_SLOT_IRQ_STATUS; break;
+            case PLL_REG_IRQ_ENABLE_ADDR: slot = PLL_SLOT_IRQ_ENABLE; break;
+            default:                      return prev_slot;  // Unmapped offsets are not part of the ordering.
+        }
+        tr_write_order.hit(prev_slot * PLL_SLOT_COUNT + slot);
+        return slot;
+    }
+
+    // What is it: Samples the divider configuration at the moment a lock sequence starts (cross coverage).
+    void sample_lock_start(unsigned n, unsigned m, unsigned od);
+
+    // What is it: Samples one state transition of `locking_process`.
+    void sample_state(PllLockState from, PllLockState to) {
+        tr_lock_fsm.hit(from * PLL_STATE_COUNT + to);
+    }
+
+    // What is it: Prints one line per coverpoint with its hit / total bins, and the holes of the small transition coverpoints.
+    void report(std::ostream& os) const;
+
+    // What is it: Save / merge, in the same spirit as the latency histograms: each parallel worker saves its database, and loading a
+    //             saved database ORs it into this one. `false` on I/O errors or a layout mismatch.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    // Bin 0 is the "illegal value" bin; legal values [lo, hi] map to bins 1 .. hi - lo + 1.
+    static unsigned value_bin(uint32_t v, uint32_t lo, uint32_t hi) {
+        return (v >= lo && v <= hi) ? v - lo + 1 : 0;
+    }
+
+    // Bin 0 is integer-N; a non-zero fraction maps to bins 1 .. 4 by its top two bits.
+    static unsigned frac_bin(uint32_t v) {
+        v &= PLL_FRAC_ONE - 1;
+        return v == 0 ? 0 : 1 + (v >> (PLL_FRAC_BITS - 2));
+    }
+
+    std::vector<CoverageBitmap*> all() const;
+
+    CoverageBitmap cp_n, cp_m, cp_od, cp_frac, cp_ctrl;
+    CoverageBitmap cx_dividers;      // N x M x OD, legal values only
+    CoverageBitmap cx_vco_band;      // N x OD x VCO band
+    CoverageBitmap tr_write_order;   // previous write slot x this write slot
+    CoverageBitmap tr_lock_fsm;      // previous state x next state
+};
+
+
+#endif // PLL_COVERAGE_H
@@ -0,0 +1,87 @@
+//
+// File: pll_divider.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the divider solver declared in `pll_divider.h`. It is a small exhaustive search: with at most 16 values of N and
+// 16 values of OD there are only 256 candidates, and for each of them the best M follows directly from the frequency equation. That is
+// cheap enough to run for every single request of a multi-million-entry DVFS trace without any caching.
+//
+
+#include "pll_divider.h"
+
+// `std::fabs` and `std::floor` for the error and rounding calculations.
+#include <cmath>
+
+
+
+// The frequency equation of the PLL. The reference frequency comes from the datasheet (`pll.h`), the same constant the model uses.
+double pll_output_mhz(const PllConfig& cfg) {
+    return (PLL_F_REF_MHZ * cfg.m) / (cfg.n * cfg.od);
+}
+
+
+
+static bool pll_divider_candidate(double target_mhz, int n, int od, PllConfig& cand);
+
+
+
+// What is it: The exhaustive search over (N, OD).
+// How it works: The loops run with N in the outer loop and only accept a strictly better error, which is what implements the
+//               "smaller N wins a tie" rule without any extra comparison.
+bool solve_pll_dividers(double target_mhz, PllConfig& cfg) {
+
+    bool   found    = false;
+    double best_err = 0.0;
+
+    // The output is the VCO frequency divided by OD >= 1, so nothing above the VCO maximum is reachable. Rejecting it here (and NaN,
+    // which fails the first comparison) also keeps the M estimate below within the range of an `int` before it is converted.
+    if (!(target_mhz > 0.0) || target_mhz > PLL_VCO_MAX_MHZ) {
+        return false;
+    }
+
+    for (int n = PLL_N_MIN; n <= PLL_N_MAX; ++n) {
+        for (int od = PLL_OD_MIN; od <= PLL_OD_MAX; ++od) {
+
+            PllConfig cand;
+            if (!pll_divider_candidate(target_mhz, n, od, cand)) {
+                continue;
+            }
+
+            double err = std::fabs(pll_output_mhz(cand) - target_mhz);
+            if (!found || err < best_err) {
+                cfg      = cand;
+                best_err = err;
+                found    = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+
+
+// What is it: Builds the best candidate for one (N, OD) pair, or rejects the pair.
+// How it works: Solving F_out = F_ref * M / (N * OD) for M gives M = F_out * N * OD / F_ref. We round to the nearest integer, then check
+//               the result against the M range and the VCO band (F_ref * M / N) from the datasheet.
+static bool pll_divider_candidate(double target_mhz, int n, int od, PllConfig& cand) {
+
+    int m = static_cast<int>(std::floor(target_mhz * n * od / PLL_F_REF_MHZ + 0.5));
+    if (m < PLL_M_MIN || m > PLL_M_MAX) {
+        return false;
+    }
+
+    double vco_mhz = PLL_F_REF_MHZ * m / n;
+    if (vco_mhz < PLL_VCO_MIN_MHZ || vco_mhz > PLL_VCO_MAX_MHZ) {
+        return false;
+    }
+
+    cand.m  = m;
+    cand.n  = n;
+    cand.od = od;
+    return true;
+}
@@ -0,0 +1,68 @@
+//
+// File: pll_divider.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the "divider solver": the piece of PMU firmware logic that answers the question "which (N, M, OD) register values
+// make the PLL produce frequency F?". The original directed test had the answer for 800 MHz pre-calculated by hand. As soon as the PMU
+// has to follow a stream of frequency requests (for example a recorded DVFS governor trace), that calculation has to be done by code,
+// for every request, within the legal ranges published in `pll.h`.
+//
+// The solver is plain C++ with no SystemC processes, so it can be used by the testbench, by reference models and by offline tools alike.
+//
+
+#ifndef PLL_DIVIDER_H
+#define PLL_DIVIDER_H
+
+
+
+// The PLL datasheet provides the reference frequency and the legal divider / VCO ranges that the solver must respect.
+#include "pll.h"
+
+
+
+//================================================================================================================================
+// C++ Concept: Data Structures (`struct`)
+//================================================================================================================================
+// What is it: This line declares a C++ `struct` named `PllConfig`. A struct (short for structure) is a composite data type that
+//             groups together variables of potentially different types under a single name. In this case, it groups three standard
+//             C++ `int` (integer) variables. By default, members of a struct are public.
+// Why is it used: It is a clean, organized way to store a complete set of PLL configuration parameters (M, N, and OD dividers). The
+//               solver below returns one, and the testbench passes it around instead of three loose variables.
+// History: I originally declared this structure in `pmu_tb.h` during the initial design phase, when it was not used yet. It moved here
+//          once the solver became its first real user.
+
+struct PllConfig { int m; int n; int od; };
+
+
+
+// What is it: An equality operator for `PllConfig`.
+// Why is it used: The trace replay skips requests whose solution is identical to what the PLL is already running, which needs a
+//               simple "same dividers?" comparison.
+inline bool operator==(const PllConfig& a, const PllConfig& b) { return a.m == b.m && a.n == b.n && a.od == b.od; }
+inline bool operator!=(const PllConfig& a, const PllConfig& b) { return !(a == b); }
+
+
+
+// What is it: Computes the output frequency, in MHz, that a given set of dividers produces: F_out = F_ref * M / (N * OD).
+double pll_output_mhz(const PllConfig& cfg);
+
+
+
+// What is it: The divider solver.
+// How it works: It tries every legal (N, OD) pair, picks the M that lands closest to the target for that pair, and discards candidates
+//               whose M or VCO frequency is outside the datasheet limits. The candidate with the smallest frequency error wins; on a tie
+//               the smaller N wins, because a higher phase-detector frequency (F_ref / N) gives a faster, quieter loop.
+// Parameters:
+//   - 'target_mhz': The requested output frequency.
+//   - 'cfg':        Output. Filled in with the best dividers found.
+// Returns: `true` if a legal configuration exists, `false` if the target is unreachable (e.g. above the VCO maximum, not positive or
+//          not a number).
+
+bool solve_pll_dividers(double target_mhz, PllConfig& cfg);
+
+
+#endif // PLL_DIVIDER_H
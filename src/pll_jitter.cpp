@@ -0,0 +1,179 @@
+//
+// File: pll_jitter.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the buffered period-jitter source declared in `pll_jitter.h`.
+//
+
+#include "pll_jitter.h"
+
+#include <cmath>
+
+#include "philox.h"
+
+
+
+PllJitterSource::PllJitterSource(const PllJitterConfig& config, uint64_t seed_value, uint32_t id)
+    : cfg(config), seed(seed_value), source_id(id), next_block(0),
+      buf(BLOCK), u1(BLOCK / 2), u2(BLOCK / 2), pos(BLOCK), stat_pos(BLOCK),
+      count(0), sum(0.0), sum_sq(0.0), min_dev(0.0), max_dev(0.0) {
+
+    if (cfg.num_spurs > PLL_JITTER_MAX_SPURS) {
+        cfg.num_spurs = PLL_JITTER_MAX_SPURS;
+    }
+    for (unsigned s = 0; s < PLL_JITTER_MAX_SPURS; ++s) {
+        spur_step[s]  = 0.0;
+        spur_phase[s] = 0.0;
+    }
+}
+
+
+
+// How it works: `spur_phase` is the phase at the first edge of the next refill, i.e. after the whole buffer. The edges 'pos' .. BLOCK
+//               were never handed out, so the phase goes back by that many steps of the old period before the new step is set.
+void PllJitterSource::set_period_ps(double period_ps) {
+    fold_stats();
+    for (unsigned s = 0; s < cfg.num_spurs; ++s) {
+        double phase = std::fmod(spur_phase[s] - spur_step[s] * (BLOCK - pos), PHILOX_TWO_PI);
+        spur_phase[s] = phase < 0.0 ? phase + PHILOX_TWO_PI : phase;
+        spur_step[s]  = std::fmod(PHILOX_TWO_PI * cfg.spurs[s].freq_mhz * 1e6 * period_ps * 1e-12, PHILOX_TWO_PI);
+    }
+    pos      = BLOCK;
+    stat_pos = BLOCK;
+}
+
+
+
+// How it works: Three passes over the block, each a simple loop over arrays:
+//   1. Philox: BLOCK / 4 counter blocks, each giving two (u1, u2) pairs. u1 is in (0, 1] so its log is finite. This pass is vectorised,
+//      one counter block per lane; the members it reads are copied to locals first, so the loop has no loads through `this`.
+//   2. Box-Muller: each pair becomes two Gaussian samples, the cosine half stored in the first half of the buffer and the sine half in
+//      the second, so both stores are contiguous. The sine is derived from the cosine, one `sqrt` instead of a second math-library
+//      call. The `log` and `cos` calls keep this pass scalar.
+//   3. Spurs: each spur adds amp * sin(phase + step * i), scalar for the same reason. The phase is carried from block to block modulo 2 pi, so it stays accurate
+//      however long the simulation runs.
+// The samples of the previous block were all handed out; they go into the statistics first.
+void PllJitterSource::refill() {
+
+    fold_stats();
+    const unsigned half = BLOCK / 2;
+
+    const uint64_t     first = next_block;
+    const uint64_t     key   = seed;
+    const uint32_t     id    = source_id;
+    double* __restrict v1    = &u1[0];
+    double* __restrict v2    = &u2[0];
+    #pragma omp simd
+    for (unsigned j = 0; j < BLOCK / 4; ++j) {
+        uint64_t block = first + j;
+        uint32_t w0 = static_cast<uint32_t>(block);
+        uint32_t w1 = static_cast<uint32_t>(block >> 32);
+        uint32_t w2 = PHILOX_STREAM_JITTER;
+        uint32_t w3 = id;
+        philox4x32_10_words(w0, w1, w2, w3, key);
+        v1[2 * j]     = (w0 + 1.0) * (1.0 / 4294967296.0);
+        v2[2 * j]     =  w1        * (1.0 / 4294967296.0);
+        v1[2 * j + 1] = (w2 + 1.0) * (1.0 / 4294967296.0);
+        v2[2 * j + 1] =  w3        * (1.0 / 4294967296.0);
+    }
+    next_block = first + BLOCK / 4;
+
+    const double rj = cfg.rj_rms_ps;
+    double* out = &buf[0];
+    for (unsigned i = 0; i < half; ++i) {
+        double r = rj * std::sqrt(-2.0 * std::log(u1[i]));
+        double c = std::cos(PHILOX_TWO_PI * u2[i]);
+        double s = std::sqrt(1.0 - c * c > 0.0 ? 1.0 - c * c : 0.0);   // sin from cos: the sign is + for angles below pi
+        out[i]        = r * c;
+        out[i + half] = u2[i] < 0.5 ? r * s : -r * s;
+    }
+
+    for (unsigned s = 0; s < cfg.num_spurs; ++s) {
+        const double amp   = cfg.spurs[s].amp_ps;
+        const double phase = spur_phase[s];
+        const double step  = spur_step[s];
+        for (unsigned i = 0; i < BLOCK; ++i) {
+            out[i] += amp * std::sin(phase + step * i);
+        }
+        spur_phase[s] = std::fmod(phase + step * BLOCK, PHILOX_TWO_PI);
+    }
+
+    pos      = 0;
+    stat_pos = 0;
+}
+
+
+
+// What is it: Adds the samples handed out since the last fold (`stat_pos` .. `pos`) to the statistics.
+void PllJitterSource::fold_stats() {
+    uint64_t n;
+    totals(n, sum, sum_sq, min_dev, max_dev);
+    count    = n;
+    stat_pos = pos;
+}
+
+
+
+// What is it: The statistics including the samples handed out but not folded in yet, without changing them.
+void PllJitterSource::totals(uint64_t& n, double& s1, double& s2, double& lo, double& hi) const {
+    n  = count;
+    s1 = sum;
+    s2 = sum_sq;
+    lo = min_dev;
+    hi = max_dev;
+    for (unsigned i = stat_pos; i < pos; ++i) {
+        double d = buf[i];
+        if (n == 0 || d < lo) lo = d;
+        if (n == 0 || d > hi) hi = d;
+        s1 += d;
+        s2 += d * d;
+        n++;
+    }
+}
+
+
+
+double PllJitterSource::rms_ps() const {
+    uint64_t n;
+    double   s1, s2, lo, hi;
+    totals(n, s1, s2, lo, hi);
+    if (n == 0) {
+        return 0.0;
+    }
+    double mean = s1 / n;
+    double var  = s2 / n - mean * mean;
+    return std::sqrt(var > 0.0 ? var : 0.0);
+}
+
+
+
+double PllJitterSource::min_ps() const {
+    uint64_t n;
+    double   s1, s2, lo, hi;
+    totals(n, s1, s2, lo, hi);
+    return n ? lo : 0.0;
+}
+
+
+
+double PllJitterSource::max_ps() const {
+    uint64_t n;
+    double   s1, s2, lo, hi;
+    totals(n, s1, s2, lo, hi);
+    return n ? hi : 0.0;
+}
+
+
+
+void PllJitterSource::print(std::ostream& os) const {
+    os << "period jitter: " << samples() << " samples, RMS " << rms_ps() << " ps, peak-to-peak " << (max_ps() - min_ps()) << " ps"
+       << " (RJ " << cfg.rj_rms_ps << " ps RMS";
+    for (unsigned s = 0; s < cfg.num_spurs; ++s) {
+        os << ", spur " << cfg.spurs[s].amp_ps << " ps @ " << cfg.spurs[s].freq_mhz << " MHz";
+    }
+    os << ")" << std::endl;
+}
@@ -0,0 +1,113 @@
+//
+// File: pll_jitter.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the period-jitter model of the PLL output clock. The ideal `clk_out` has every period exactly equal to
+// 1 / F_out; a real PLL's periods scatter around that value. The model adds two components to every period:
+//
+//   - Random jitter (RJ):        Gaussian, with a given RMS in picoseconds. It stands for the thermal and flicker noise of the VCO and
+//                                charge pump, integrated over one period.
+//   - Deterministic jitter (DJ): Up to `PLL_JITTER_MAX_SPURS` sinusoidal spurs, each with a peak period deviation in picoseconds and a
+//                                modulation frequency in MHz, e.g. reference feed-through or supply ripple.
+//
+// Why a buffer: At 800 MHz the PLL generates 1.6 billion edges per simulated second, so the per-edge cost of the noise is what matters.
+// Drawing each sample on demand (`std::normal_distribution` plus a `sin` per spur) costs tens of nanoseconds per edge. Here the samples
+// are produced `BLOCK` at a time into a buffer allocated once: Philox integers, then Box-Muller and the spurs as plain loops over arrays.
+// The Philox loop is SIMD code in every configuration (`#pragma omp simd` and the Makefile's `SIMD_FLAGS`). Box-Muller and the spurs
+// call `log`, `cos` and `sin`, which have no vector versions without -ffast-math, so they run scalar. The per-edge cost is one array
+// read and a compare.
+//
+// Reproducibility: The random part is a pure function of (seed, source id, sample number) through Philox (`philox.h`), so every PLL
+// in a system gets its own independent, repeatable noise.
+//
+
+#ifndef PLL_JITTER_H
+#define PLL_JITTER_H
+
+
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+
+
+#define PLL_JITTER_MAX_SPURS 4
+
+
+
+// What is it: One deterministic spur: a sinusoidal period deviation of peak 'amp_ps' at modulation frequency 'freq_mhz'.
+struct PllSpur {
+    double amp_ps;
+    double freq_mhz;
+};
+
+
+
+// What is it: The jitter specification of one PLL output. All zero means an ideal clock.
+struct PllJitterConfig {
+    double   rj_rms_ps;
+    unsigned num_spurs;
+    PllSpur  spurs[PLL_JITTER_MAX_SPURS];
+};
+
+
+
+class PllJitterSource {
+public:
+    static const unsigned BLOCK = 4096;   // Samples per refill. Even, and a multiple of 4 (one Philox block gives two Gaussian pairs).
+
+    // 'source_id' separates the noise of different PLLs driven by the same seed.
+    PllJitterSource(const PllJitterConfig& cfg, uint64_t seed, uint32_t source_id);
+
+    // What is it: Tells the source the nominal output period, which sets the phase advance of the spurs per edge. Called at every lock.
+    //             Samples already in the buffer were computed for the old period, so they are dropped, and the spurs are rewound to the
+    //             phase of the first dropped sample: the spur waveform continues from the last edge handed out.
+    void set_period_ps(double period_ps);
+
+    // What is it: The deviation of the next period from nominal, in picoseconds.
+    double next() {
+        if (pos == BLOCK) {
+            refill();
+        }
+        return buf[pos++];
+    }
+
+    // What is it: Statistics of every sample handed out by `next()` so far. Samples that were generated but dropped, or are still in the
+    //             buffer, are not in them. They are folded in per block (at a refill or a period change), not per edge.
+    uint64_t samples() const { return count + (pos - stat_pos); }
+    double   rms_ps()  const;
+    double   min_ps()  const;
+    double   max_ps()  const;
+
+    // What is it: Prints a one-line summary: samples, RMS and peak-to-peak period jitter.
+    void print(std::ostream& os) const;
+
+private:
+    void refill();
+    void fold_stats();
+    void totals(uint64_t& n, double& s1, double& s2, double& lo, double& hi) const;
+
+    PllJitterConfig cfg;
+    uint64_t        seed;
+    uint32_t        source_id;
+    uint64_t        next_block;            // Philox counter of the next random block
+
+    double          spur_step[PLL_JITTER_MAX_SPURS];    // Phase advance per edge, radians
+    double          spur_phase[PLL_JITTER_MAX_SPURS];   // Phase at the first edge of the next refill
+
+    std::vector<double> buf;               // The samples handed out by `next()`
+    std::vector<double> u1, u2;            // Scratch: the uniforms of one refill
+    unsigned            pos;
+    unsigned            stat_pos;          // Samples before it (from `buf[0]`) are in the statistics; `stat_pos` .. `pos` are not yet
+
+    uint64_t count;
+    double   sum, sum_sq, min_dev, max_dev;
+};
+
+
+#endif // PLL_JITTER_H
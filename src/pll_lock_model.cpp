@@ -0,0 +1,62 @@
+//
+// File: pll_lock_model.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the scalar lock-time model declared in `pll_lock_model.h`.
+//
+
+#include "pll_lock_model.h"
+
+#include <cmath>
+#include <limits>
+
+
+
+PllAnalogParams pll_nominal_analog() {
+    PllAnalogParams p = { 0.0, PLL_KVCO_MHZ_PER_V, PLL_VCO_F0_MHZ, PLL_ICP_UA, PLL_LF_R_KOHM, PLL_LF_C_PF };
+    return p;
+}
+
+
+
+// How it works: The settling time uses the envelope of the slowest pole, -ln(tol) / Re(slowest pole). For an underdamped loop that is
+//               zeta * wn, for an overdamped one wn * (zeta - sqrt(zeta^2 - 1)); the two meet at zeta = 1, so the model has no step there
+//               and can be written without a branch. `pll_monte_carlo.cpp` relies on that.
+PllLockResult pll_lock_model(const PllAnalogParams& p, const PllConfig& cfg) {
+
+    PllLockResult r;
+
+    if (cfg.n == 0 || cfg.od == 0 || cfg.m == 0) {
+        r.locks        = false;
+        r.lock_ns      = 0.0;
+        r.freq_err_ppm = std::numeric_limits<double>::quiet_NaN();
+        return r;
+    }
+
+    double vco_ideal  = PLL_F_REF_MHZ * cfg.m / cfg.n;
+    double vco_target = vco_ideal * (1.0 + p.ref_ppm * 1e-6);
+
+    // The tuning voltage that puts the VCO on target, and whether the charge pump can get there.
+    double vtune   = (vco_target - p.f0_mhz) / p.kvco_mhz_v;
+    double vclamp  = vtune < 0.0 ? 0.0 : vtune > PLL_VTUNE_MAX_V ? PLL_VTUNE_MAX_V : vtune;
+    double vco_out = p.f0_mhz + p.kvco_mhz_v * vclamp;
+
+    r.locks        = vtune >= 0.0 && vtune <= PLL_VTUNE_MAX_V;
+    r.freq_err_ppm = (vco_out - vco_ideal) / vco_ideal * 1e6;
+
+    // Slew: C * V / I, with pF * V / uA = us.
+    double slew_ns = p.c_pf * vclamp / p.icp_ua * 1000.0;
+
+    // Settle: wn in rad/s from I_cp [A], K_vco [Hz/V], C [F]; zeta from R [Ohm].
+    double wn    = std::sqrt(p.icp_ua * 1e-6 * p.kvco_mhz_v * 1e6 / (cfg.m * p.c_pf * 1e-12));
+    double zeta  = p.r_kohm * 1e3 * p.c_pf * 1e-12 * wn / 2.0;
+    double over  = zeta * zeta - 1.0;
+    double decay = wn * (zeta - std::sqrt(over > 0.0 ? over : 0.0));   // = zeta * wn when underdamped
+
+    r.lock_ns = slew_ns + (-std::log(PLL_LOCK_TOL) / decay) * 1e9;
+    return r;
+}
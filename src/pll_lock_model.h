@@ -0,0 +1,79 @@
+//
+// File: pll_lock_model.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the parametric lock-time model of the PLL. The behavioural model in `pll.cpp` uses a fixed acquisition time
+// (`PLL_LOCK_TIME_NS`); a real PLL's lock time depends on the divider setting and on the analog parameters of the particular die. This
+// model computes it from a classic charge-pump PLL with a second-order (type-II) loop:
+//
+//   1. Slew:   After ENABLE the tuning voltage starts at 0 V and the charge pump ramps it towards the voltage that puts the VCO on
+//              F_ref * M / N. This takes C * V_tune / I_cp. If that voltage lies outside the tuning range, the PLL never locks.
+//   2. Settle: The loop then rings down like a damped second-order system with natural frequency wn = sqrt(I_cp * K_vco / (M * C)) and
+//              damping zeta = R * C * wn / 2, until the remaining error is below PLL_LOCK_TOL of the step.
+//
+// The final frequency error of a locked PLL is the reference error (the loop copies the reference exactly); of a PLL that failed to
+// lock, it is how far the VCO got at the end of its tuning range.
+//
+// This is the scalar reference. The Monte Carlo engine (`pll_monte_carlo.h`) evaluates the same equations on whole batches of dies.
+//
+
+#ifndef PLL_LOCK_MODEL_H
+#define PLL_LOCK_MODEL_H
+
+
+
+#include "pll_divider.h"
+
+
+
+// What is it: The nominal analog design values, as the electrical characteristics table of the datasheet would give them, and the
+//             1-sigma process spread of each one. The nominal die locks an 800 MHz configuration in about 520 ns.
+#define PLL_REF_PPM_SIGMA       20.0     // Reference crystal accuracy (1 sigma, ppm). A +-50 ppm crystal is about 2.5 sigma.
+#define PLL_KVCO_MHZ_PER_V      1000.0   // VCO gain
+#define PLL_KVCO_SIGMA          0.10     // relative
+#define PLL_VCO_F0_MHZ          400.0    // VCO frequency at V_tune = 0
+#define PLL_VCO_F0_SIGMA        0.05     // relative
+#define PLL_VTUNE_MAX_V         1.2      // Top of the tuning range. Nominally F0 + K_vco * 1.2 V = 1600 MHz, the top of the VCO band.
+#define PLL_ICP_UA              200.0    // Charge pump current
+#define PLL_ICP_SIGMA           0.05     // relative
+#define PLL_LF_R_KOHM           4.7      // Loop filter zero resistor
+#define PLL_LF_R_SIGMA          0.05     // relative
+#define PLL_LF_C_PF             14.0     // Loop filter capacitor
+#define PLL_LF_C_SIGMA          0.05     // relative
+#define PLL_LOCK_TOL            1e-3     // The lock detector fires once the residual error is below this fraction of the step.
+
+
+
+// What is it: The analog parameters of one die.
+struct PllAnalogParams {
+    double ref_ppm;        // Reference clock frequency error, ppm
+    double kvco_mhz_v;     // VCO gain, MHz/V
+    double f0_mhz;         // VCO frequency at V_tune = 0, MHz
+    double icp_ua;         // Charge pump current, uA
+    double r_kohm;         // Loop filter resistor, kOhm
+    double c_pf;           // Loop filter capacitor, pF
+};
+
+
+
+// What is it: What the model predicts for one die and one divider configuration.
+struct PllLockResult {
+    bool   locks;          // False if the VCO cannot reach the target inside its tuning range (or a divider is 0).
+    double lock_ns;        // Time from ENABLE to the lock interrupt. Only meaningful if 'locks'.
+    double freq_err_ppm;   // Output frequency error against the ideal F_ref * M / (N * OD).
+};
+
+
+
+// What is it: The parameters of the nominal die: every spread at zero.
+PllAnalogParams pll_nominal_analog();
+
+// What is it: Evaluates the lock-time model for one die and one configuration.
+PllLockResult pll_lock_model(const PllAnalogParams& p, const PllConfig& cfg);
+
+
+#endif // PLL_LOCK_MODEL_H
@@ -0,0 +1,79 @@
+//
+// File: pll_lock_timer.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the shared lock timer declared in `pll_lock_timer.h`.
+//
+
+#include "pll_lock_timer.h"
+#include "pll.h"
+#include "pll_time.h"
+
+
+
+pll_lock_timer::pll_lock_timer(sc_module_name name, unsigned capacity)
+    : sc_module(name), wheel(capacity), clients(capacity, NULL), armed_ps(PLL_LOCK_TIMER_IDLE) {
+
+    SC_METHOD(timer_process);
+    sensitive << timer_event;
+    dont_initialize();
+}
+
+
+
+void pll_lock_timer::attach(unsigned id, pll* p) {
+    clients[id] = p;
+    p->set_lock_timer(this, id);
+}
+
+
+
+// How it works: `timer_event` is only moved forward in time. A later deadline is found when the timer wakes up.
+void pll_lock_timer::schedule(unsigned id, uint64_t deadline_ps) {
+    wheel.schedule(id, deadline_ps);
+    if (deadline_ps < armed_ps) {
+        arm_timer(deadline_ps);
+    }
+}
+
+
+
+// How it works: Only the wheel is updated. `timer_event` stays set; every deadline still pending is at or after it, so waking then is
+//               at worst a wake-up that fires nothing.
+void pll_lock_timer::cancel(unsigned id) {
+    if (wheel.armed(id)) {
+        wheel.cancel(id);
+    }
+}
+
+
+
+// What is it: Advances the wheel to the current time and wakes every PLL that is due now, then re-arms for the earliest deadline left.
+void pll_lock_timer::timer_process() {
+
+    armed_ps = PLL_LOCK_TIMER_IDLE;
+    fired.clear();
+    wheel.advance(sc_time_to_ps(sc_time_stamp()), fired);
+    for (size_t k = 0; k < fired.size(); ++k) {
+        clients[fired[k]]->lock_deadline_reached();
+    }
+
+    if (!wheel.empty()) {
+        arm_timer(wheel.next_deadline());
+    }
+}
+
+
+
+// What is it: Points `timer_event` at 'deadline_ps', like `pll_bank::arm_timer()`. A deadline of now is a delta notification, exactly
+//             like a zero lock time in the `next_trigger()` of a `pll`.
+void pll_lock_timer::arm_timer(uint64_t deadline_ps) {
+    uint64_t now_ps = sc_time_to_ps(sc_time_stamp());
+    timer_event.cancel();
+    timer_event.notify(sc_time(static_cast<double>(deadline_ps - now_ps), SC_PS));
+    armed_ps = deadline_ps;
+}
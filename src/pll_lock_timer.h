@@ -0,0 +1,78 @@
+//
+// File: pll_lock_timer.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `pll_lock_timer`, the one lock timer shared by every standalone `pll` of a system. On its own, a `pll` waits for
+// its lock time with a timed `next_trigger()`, which puts one timed notification per locking PLL into the kernel's event queue. With
+// thousands of PLLs relocking under DFS, that queue is what the simulation spends its time on.
+//
+// How it works: Every attached PLL hands its lock deadline to the timer instead (`schedule()`), and waits for its own command event or
+// for the timer. The timer keeps the deadlines in a `PllTimerWheel` (the one `pll_bank` uses), notifies one kernel event for the earliest,
+// and when it fires, wakes every PLL due at that instant in one pass. A PLL that is disabled, reset or re-targeted before its deadline
+// cancels it, in O(1). The kernel event is only moved when a new deadline is earlier than the one it is set for; a cancel leaves it
+// alone, and if the deadline it was set for is gone by then, the timer wakes once for nothing and sets it for the next one. Finding the
+// earliest deadline walks the slot it is in, so it is done once per wake-up, not once per schedule or cancel.
+//
+// The PLL is woken with an immediate notification of its `lock_deadline_event`, so its `locking_process` runs in the same delta cycle as
+// the timer, which is the delta cycle its own timed `next_trigger()` would have run it in.
+//
+
+#ifndef PLL_LOCK_TIMER_H
+#define PLL_LOCK_TIMER_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "pll_timer_wheel.h"
+
+
+
+#define PLL_LOCK_TIMER_IDLE UINT64_MAX       // `armed_ps` when `timer_event` is not set
+
+
+
+class pll;
+
+
+
+SC_MODULE(pll_lock_timer) {
+
+    // What is it: A timer for the PLLs 0 .. 'capacity' - 1 of the system (the timer id of a PLL is its index).
+    pll_lock_timer(sc_module_name name, unsigned capacity);
+
+    SC_HAS_PROCESS(pll_lock_timer);
+
+
+
+    // What is it: Makes PLL 'p' use this timer, as timer 'id'. Called during elaboration.
+    void attach(unsigned id, pll* p);
+
+    // What is it: The lock deadline of timer 'id' is 'deadline_ps' (not before now); a pending one is replaced. Called by the PLL.
+    void schedule(unsigned id, uint64_t deadline_ps);
+
+    // What is it: Cancels the pending lock deadline of timer 'id', if any. Called by the PLL.
+    void cancel(unsigned id);
+
+
+
+private:
+    PllTimerWheel         wheel;
+    std::vector<pll*>     clients;
+    std::vector<uint32_t> fired;
+    sc_event              timer_event;
+    uint64_t              armed_ps;          // When `timer_event` fires, or `PLL_LOCK_TIMER_IDLE`
+
+    void timer_process();
+    void arm_timer(uint64_t deadline_ps);
+};
+
+
+#endif // PLL_LOCK_TIMER_H
@@ -0,0 +1,170 @@
+//
+// File: pll_monte_carlo.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the Monte Carlo engine declared in `pll_monte_carlo.h`: drawing a batch of dies, the vectorised model kernel and
+// the per-configuration statistics.
+//
+
+#include "pll_monte_carlo.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "philox.h"
+
+
+
+// How it works: Each die takes six 32-bit words from its own Philox stream, turned into three pairs of standard normal variates by the
+//               Box-Muller transform. The integer part runs over many dies at once, one vector lane per die. The transform stays scalar:
+//               it calls `log`, `sin` and `cos`, which have no vector versions without -ffast-math, but it is still a tight loop.
+void PllMonteCarlo::draw(uint64_t first, unsigned count, PllMcBatch& b) const {
+
+    // The uniforms are parked in the output arrays of the batch, which the kernel overwrites anyway. u1 is in (0, 1] so log(u1) is
+    // finite; u2 is in [0, 1).
+    double* u1[3] = { b.locks, b.lock_ns, b.freq_err_ppm };
+    double* u2[3] = { b.ref_ppm, b.kvco_mhz_v, b.f0_mhz };
+
+    // Die 'i' is the (seed, stream, first + i) counter of `PhiloxStream`: words 0 .. 3 from block 0, words 4 and 5 from block 1.
+    const uint64_t key = mc_seed;
+    double* __restrict u10 = u1[0];
+    double* __restrict u11 = u1[1];
+    double* __restrict u12 = u1[2];
+    double* __restrict u20 = u2[0];
+    double* __restrict u21 = u2[1];
+    double* __restrict u22 = u2[2];
+    #pragma omp simd
+    for (unsigned i = 0; i < count; ++i) {
+        uint64_t index = first + i;
+        uint32_t a0 = static_cast<uint32_t>(index), a1 = static_cast<uint32_t>(index >> 32), a2 = PHILOX_STREAM_MONTE_CARLO, a3 = 0;
+        uint32_t b0 = a0, b1 = a1, b2 = a2, b3 = 1;
+        philox4x32_10_words(a0, a1, a2, a3, key);
+        philox4x32_10_words(b0, b1, b2, b3, key);
+        u10[i] = (a0 + 1.0) * (1.0 / 4294967296.0);
+        u20[i] =  a1        * (1.0 / 4294967296.0);
+        u11[i] = (a2 + 1.0) * (1.0 / 4294967296.0);
+        u21[i] =  a3        * (1.0 / 4294967296.0);
+        u12[i] = (b0 + 1.0) * (1.0 / 4294967296.0);
+        u22[i] =  b1        * (1.0 / 4294967296.0);
+    }
+
+    for (unsigned i = 0; i < count; ++i) {
+        double r0 = std::sqrt(-2.0 * std::log(u1[0][i]));
+        double r1 = std::sqrt(-2.0 * std::log(u1[1][i]));
+        double r2 = std::sqrt(-2.0 * std::log(u1[2][i]));
+        double a0 = PHILOX_TWO_PI * u2[0][i], a1 = PHILOX_TWO_PI * u2[1][i], a2 = PHILOX_TWO_PI * u2[2][i];
+
+        b.icp_ua[i]     = PLL_ICP_UA         * (1.0 + PLL_ICP_SIGMA    * r0 * std::sin(a0));
+        b.r_kohm[i]     = PLL_LF_R_KOHM      * (1.0 + PLL_LF_R_SIGMA   * r1 * std::sin(a1));
+        b.c_pf[i]       = PLL_LF_C_PF        * (1.0 + PLL_LF_C_SIGMA   * r2 * std::sin(a2));
+        b.ref_ppm[i]    =                             PLL_REF_PPM_SIGMA * r0 * std::cos(a0);
+        b.kvco_mhz_v[i] = PLL_KVCO_MHZ_PER_V * (1.0 + PLL_KVCO_SIGMA   * r1 * std::cos(a1));
+        b.f0_mhz[i]     = PLL_VCO_F0_MHZ     * (1.0 + PLL_VCO_F0_SIGMA * r2 * std::cos(a2));
+    }
+}
+
+
+
+// How it works: The same equations as `pll_lock_model()`, with every `if` turned into a select (`?:` on doubles compiles to a compare
+//               and a blend) and the constant log(PLL_LOCK_TOL) hoisted out of the loop. The loop body then has no calls but `sqrt`,
+//               which is a single instruction with `-fno-math-errno`, and `#pragma omp simd` vectorises the whole loop even at -O2.
+void PllMonteCarlo::evaluate(const PllConfig& cfg, unsigned count, PllMcBatch& b) {
+
+    if (cfg.n == 0 || cfg.od == 0 || cfg.m == 0) {
+        for (unsigned i = 0; i < count; ++i) {
+            b.locks[i]        = 0.0;
+            b.lock_ns[i]      = 0.0;
+            b.freq_err_ppm[i] = std::nan("");
+        }
+        return;
+    }
+
+    const double vco_ideal = PLL_F_REF_MHZ * cfg.m / cfg.n;
+    const double settle_k  = -std::log(PLL_LOCK_TOL) * 1e9;
+    const double wn_k      = 1e-6 * 1e6 / (cfg.m * 1e-12);   // the unit conversions of wn, with M folded in
+    const double zeta_k    = 1e3 * 1e-12 / 2.0;
+
+    #pragma omp simd
+    for (unsigned i = 0; i < count; ++i) {
+        double vco_target = vco_ideal * (1.0 + b.ref_ppm[i] * 1e-6);
+        double vtune      = (vco_target - b.f0_mhz[i]) / b.kvco_mhz_v[i];
+        double vclamp     = vtune < 0.0 ? 0.0 : vtune > PLL_VTUNE_MAX_V ? PLL_VTUNE_MAX_V : vtune;
+        double vco_out    = b.f0_mhz[i] + b.kvco_mhz_v[i] * vclamp;
+
+        double slew_ns = b.c_pf[i] * vclamp / b.icp_ua[i] * 1000.0;
+        double wn      = std::sqrt(b.icp_ua[i] * b.kvco_mhz_v[i] * wn_k / b.c_pf[i]);
+        double zeta    = b.r_kohm[i] * b.c_pf[i] * zeta_k * wn;
+        double over    = zeta * zeta - 1.0;
+        double decay   = wn * (zeta - std::sqrt(over > 0.0 ? over : 0.0));
+
+        b.locks[i]        = (vtune >= 0.0 && vtune <= PLL_VTUNE_MAX_V) ? 1.0 : 0.0;
+        b.lock_ns[i]      = slew_ns + settle_k / decay;
+        b.freq_err_ppm[i] = (vco_out - vco_ideal) / vco_ideal * 1e6;
+    }
+}
+
+
+
+void PllMonteCarlo::run(const PllConfig& cfg, uint64_t samples, PllMcResult& res) const {
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    // ~100 KB: too big for comfort on a thread stack.
+    std::vector<PllMcBatch> storage(1);
+    PllMcBatch& b = storage[0];
+
+    res.cfg = cfg;
+
+    for (uint64_t first = 0; first < samples; first += PllMcBatch::SIZE) {
+        unsigned count = samples - first < PllMcBatch::SIZE ? static_cast<unsigned>(samples - first) : PllMcBatch::SIZE;
+
+        draw(first, count, b);
+        evaluate(cfg, count, b);
+
+        // The statistics are scalar: the histogram update is a data-dependent index, which does not vectorise, but costs little
+        // next to the two Philox blocks and the Box-Muller transform per die.
+        for (unsigned i = 0; i < count; ++i) {
+            double err = b.freq_err_ppm[i];
+            if (b.locks[i] != 0.0) {
+                res.lock_hist.record(static_cast<uint64_t>(b.lock_ns[i] + 0.5));
+                res.err_sum    += err;
+                res.err_sq_sum += err * err;
+                if (std::fabs(err) > res.err_max_abs) res.err_max_abs = std::fabs(err);
+            } else {
+                res.failures++;
+                if (std::fabs(err) > res.fail_err_max_abs) res.fail_err_max_abs = std::fabs(err);
+            }
+        }
+        res.samples += count;
+    }
+
+    res.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+
+
+void PllMcResult::print(std::ostream& os) const {
+
+    uint64_t locked = samples - failures;
+    double   mean   = locked ? err_sum / locked : 0.0;
+    double   var    = locked ? err_sq_sum / locked - mean * mean : 0.0;
+
+    os << "N=" << cfg.n << " M=" << cfg.m << " OD=" << cfg.od << " (" << PLL_F_REF_MHZ * cfg.m / (cfg.n * cfg.od) << " MHz): "
+       << samples << " dies, " << failures << " cannot lock (" << (samples ? 100.0 * failures / samples : 0.0) << " %)";
+    if (failures > 0) {
+        os << ", worst miss " << fail_err_max_abs << " ppm";
+    }
+    os << std::endl;
+
+    os << "    lock:  p50 " << lock_hist.percentile(0.50) << " ns, p99 " << lock_hist.percentile(0.99) << " ns, p99.9 "
+       << lock_hist.percentile(0.999) << " ns, p99.99 " << lock_hist.percentile(0.9999) << " ns, max " << lock_hist.max() << " ns"
+       << std::endl;
+    os << "    error: mean " << mean << " ppm, sigma " << std::sqrt(var > 0.0 ? var : 0.0) << " ppm, max |err| " << err_max_abs << " ppm"
+       << std::endl;
+    os << "    " << (seconds > 0.0 ? samples / seconds : 0.0) << " dies/s" << std::endl;
+}
@@ -0,0 +1,105 @@
+//
+// File: pll_monte_carlo.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the Monte Carlo engine for process variation. It draws a population of dies (reference clock error, VCO gain and
+// free-running frequency, charge pump current and loop filter R and C, each from a normal distribution around its nominal value in
+// `pll_lock_model.h`) and evaluates the lock-time model for every die at a given divider configuration. Guard bands are sized from the
+// tails of the resulting distributions: the lock time at p99.9 and above, the worst frequency error, the fraction of dies that cannot
+// lock at all.
+//
+// Why not simulate: Sizing a p99.9 guard band takes millions of dies per configuration. One `sc_main` run per die costs milliseconds
+// of elaboration alone. Here no SystemC is involved: dies are evaluated in batches of `PllMcBatch::SIZE`, with the parameters stored as
+// one array per parameter (structure of arrays). The model has no branches and no calls other than `sqrt`, and the batch loop is marked
+// `#pragma omp simd`, so with the Makefile's `SIMD_FLAGS` it is SIMD code in every configuration: two doubles per SSE2 instruction in
+// `release`, four with AVX2 in `perf` (`-march=native`). So is the Philox part of drawing the dies. A few dies can still be checked
+// against the full SystemC model: `main.cpp --mc-spot` does that.
+//
+// Die 'i' is a pure function of (seed, i) through Philox (`philox.h`), and does not depend on the configuration: the same population is
+// evaluated at every configuration, as the same chips would be.
+//
+
+#ifndef PLL_MONTE_CARLO_H
+#define PLL_MONTE_CARLO_H
+
+
+
+#include <cstdint>
+#include <ostream>
+
+#include "pll_lock_model.h"
+#include "latency_histogram.h"
+
+
+
+// What is it: One batch of dies, inputs and outputs, as a structure of arrays. Every field is a separate contiguous array, so each step
+//             of the model is one pass over a few arrays that vectorises without gathers. It is about 100 KB; allocate it on the heap.
+struct PllMcBatch {
+    static const unsigned SIZE = 1024;
+
+    // Inputs: the drawn parameters of every die (see `PllAnalogParams`).
+    double ref_ppm[SIZE];
+    double kvco_mhz_v[SIZE];
+    double f0_mhz[SIZE];
+    double icp_ua[SIZE];
+    double r_kohm[SIZE];
+    double c_pf[SIZE];
+
+    // Outputs: see `PllLockResult`. 'locks' is 1.0 or 0.0, a double so that the whole kernel works on one element width.
+    double locks[SIZE];
+    double lock_ns[SIZE];
+    double freq_err_ppm[SIZE];
+
+    // What is it: The parameters of die 'i' of this batch, in the form the scalar model and the PLL take.
+    PllAnalogParams params(unsigned i) const {
+        PllAnalogParams p = { ref_ppm[i], kvco_mhz_v[i], f0_mhz[i], icp_ua[i], r_kohm[i], c_pf[i] };
+        return p;
+    }
+};
+
+
+
+// What is it: The summary of one configuration's population.
+struct PllMcResult {
+    PllMcResult() : lock_hist("mc_lock_time"), samples(0), failures(0), err_sum(0.0), err_sq_sum(0.0), err_max_abs(0.0),
+                    fail_err_max_abs(0.0), seconds(0.0) {}
+
+    PllConfig        cfg;
+    LatencyHistogram lock_hist;         // Lock time of the dies that lock, ns.
+    uint64_t         samples;
+    uint64_t         failures;          // Dies that cannot reach the target frequency.
+    double           err_sum;           // Frequency error of the dies that lock, ppm: sum, sum of squares and largest magnitude.
+    double           err_sq_sum;
+    double           err_max_abs;
+    double           fail_err_max_abs;  // The largest frequency error among the dies that do not lock, ppm.
+    double           seconds;           // Wall-clock time of the evaluation.
+
+    void print(std::ostream& os) const;
+};
+
+
+
+class PllMonteCarlo {
+public:
+    explicit PllMonteCarlo(uint64_t seed) : mc_seed(seed) {}
+
+    // What is it: Draws dies [first, first + count) into 'b' (count <= PllMcBatch::SIZE).
+    void draw(uint64_t first, unsigned count, PllMcBatch& b) const;
+
+    // What is it: Evaluates the lock-time model for the first 'count' dies of 'b' at configuration 'cfg'. This is the vectorised kernel;
+    //             it gives the same results as `pll_lock_model()` die by die, up to floating-point rounding.
+    static void evaluate(const PllConfig& cfg, unsigned count, PllMcBatch& b);
+
+    // What is it: Draws and evaluates dies [0, samples) at 'cfg' and accumulates them into 'res'.
+    void run(const PllConfig& cfg, uint64_t samples, PllMcResult& res) const;
+
+private:
+    uint64_t mc_seed;
+};
+
+
+#endif // PLL_MONTE_CARLO_H
@@ -0,0 +1,36 @@
+//
+// File: pll_pch.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header is the precompiled header of the build (`make PCH=1`, the default). It is never included by the sources themselves: the
+// Makefile compiles it once into `pll_pch.h.gch` and force-includes it (`-include`) at the top of every translation unit, where GCC
+// loads the precompiled image instead of parsing the text again.
+//
+// Why: `systemc.h` pulls in the whole SystemC kernel, data types and a large part of the standard library, tens of thousands of lines
+// that every module parses again and that dominate the compile time of each file. Only stable headers belong here: anything in this
+// file that changes rebuilds the image and then every object.
+//
+
+#ifndef PLL_PCH_H
+#define PLL_PCH_H
+
+
+
+#include <systemc.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+#endif // PLL_PCH_H
@@ -0,0 +1,157 @@
+//
+// File: pll_power.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the power table and the transition-driven energy meter declared in `pll_power.h`.
+//
+
+#include "pll_power.h"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+
+
+// The built-in table: plausible values for a small ring-oscillator PLL in a 28 nm class process. A locked PLL at 800 MHz draws 5.2 mW.
+PllPowerTable::PllPowerTable()
+    : off_mw(0.005), acquire_mw(6.0), relock_mw(4.0), locked_mw(2.0), locked_mw_per_mhz(0.004), bus_write_pj(2.0) {
+}
+
+
+
+bool PllPowerTable::load(const std::string& path) {
+
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "POWER: Cannot read '" << path << "'." << std::endl;
+        return false;
+    }
+
+    // Parse into a copy, so that a bad file leaves the table as it was.
+    PllPowerTable t = *this;
+    std::string line;
+    unsigned line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        std::string::size_type hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.erase(hash);
+        }
+
+        std::istringstream fields(line);
+        std::string key;
+        double value;
+        if (!(fields >> key)) {
+            continue;   // blank or comment-only line
+        }
+        if (!(fields >> value)) {
+            std::cerr << "POWER: '" << path << "' line " << line_no << ": no value for '" << key << "'." << std::endl;
+            return false;
+        }
+
+        if      (key == "off_mw")            t.off_mw            = value;
+        else if (key == "acquire_mw")        t.acquire_mw        = value;
+        else if (key == "relock_mw")         t.relock_mw         = value;
+        else if (key == "locked_mw")         t.locked_mw         = value;
+        else if (key == "locked_mw_per_mhz") t.locked_mw_per_mhz = value;
+        else if (key == "bus_write_pj")      t.bus_write_pj      = value;
+        else {
+            std::cerr << "POWER: '" << path << "' line " << line_no << ": unknown key '" << key << "'." << std::endl;
+            return false;
+        }
+    }
+
+    *this = t;
+    return true;
+}
+
+
+
+PllPowerMeter::PllPowerMeter() : state(PLL_STATE_OFF), state_mhz(0.0), since_ps(0), writes(0) {
+    for (unsigned s = 0; s < PLL_STATE_COUNT; ++s) {
+        state_ps[s] = 0;
+    }
+}
+
+
+
+void PllPowerMeter::close(uint64_t now_ps, uint64_t* ps, std::map<double, uint64_t>& locked) const {
+    uint64_t dt = now_ps > since_ps ? now_ps - since_ps : 0;
+    ps[state] += dt;
+    if (state == PLL_STATE_LOCKED) {
+        locked[state_mhz] += dt;
+    }
+}
+
+
+
+void PllPowerMeter::transition(PllLockState next, double out_mhz, uint64_t now_ps) {
+    close(now_ps, state_ps, locked_ps);
+    state     = next;
+    state_mhz = (next == PLL_STATE_LOCKED) ? out_mhz : 0.0;
+    since_ps  = now_ps;
+}
+
+
+
+uint64_t PllPowerMeter::time_ps(PllLockState s, uint64_t now_ps) const {
+    uint64_t t = state_ps[s];
+    if (s == state && now_ps > since_ps) {
+        t += now_ps - since_ps;
+    }
+    return t;
+}
+
+
+
+// How it works: mW * ps = 1e-3 J/s * 1e-12 s = 1e-15 J = 1e-6 nJ, and pJ = 1e-3 nJ.
+double PllPowerMeter::energy_nj(const PllPowerTable& table, uint64_t now_ps) const {
+
+    uint64_t ps[PLL_STATE_COUNT];
+    for (unsigned s = 0; s < PLL_STATE_COUNT; ++s) {
+        ps[s] = state_ps[s];
+    }
+    std::map<double, uint64_t> locked = locked_ps;
+    close(now_ps, ps, locked);
+
+    double e = (table.off_mw * ps[PLL_STATE_OFF] + table.acquire_mw * ps[PLL_STATE_ACQUIRE] +
+                table.relock_mw * ps[PLL_STATE_RELOCK]) * 1e-6;
+    for (std::map<double, uint64_t>::const_iterator it = locked.begin(); it != locked.end(); ++it) {
+        e += (table.locked_mw + table.locked_mw_per_mhz * it->first) * it->second * 1e-6;
+    }
+    return e + table.bus_write_pj * writes * 1e-3;
+}
+
+
+
+void PllPowerMeter::print(std::ostream& os, const std::string& name, const PllPowerTable& table, uint64_t now_ps) const {
+
+    uint64_t ps[PLL_STATE_COUNT];
+    for (unsigned s = 0; s < PLL_STATE_COUNT; ++s) {
+        ps[s] = state_ps[s];
+    }
+    std::map<double, uint64_t> locked = locked_ps;
+    close(now_ps, ps, locked);
+
+    double e_total = energy_nj(table, now_ps);
+    os << name << ": " << e_total << " nJ";
+    if (now_ps > 0) {
+        os << " (average " << e_total / (now_ps * 1e-6) << " mW)";   // nJ / us = mW
+    }
+    os << std::endl;
+
+    os << "    off "      << ps[PLL_STATE_OFF]     / 1000.0 << " ns: " << table.off_mw     * ps[PLL_STATE_OFF]     * 1e-6 << " nJ, "
+       << "acquire "      << ps[PLL_STATE_ACQUIRE] / 1000.0 << " ns: " << table.acquire_mw * ps[PLL_STATE_ACQUIRE] * 1e-6 << " nJ, "
+       << "relock "       << ps[PLL_STATE_RELOCK]  / 1000.0 << " ns: " << table.relock_mw  * ps[PLL_STATE_RELOCK]  * 1e-6 << " nJ, "
+       << writes << " writes: " << table.bus_write_pj * writes * 1e-3 << " nJ" << std::endl;
+
+    for (std::map<double, uint64_t>::const_iterator it = locked.begin(); it != locked.end(); ++it) {
+        os << "    locked at " << it->first << " MHz " << it->second / 1000.0 << " ns: "
+           << (table.locked_mw + table.locked_mw_per_mhz * it->first) * it->second * 1e-6 << " nJ" << std::endl;
+    }
+}
@@ -0,0 +1,89 @@
+//
+// File: pll_power.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the power and energy estimation of the PLL: a per-state power table, and a meter that records how long one PLL
+// spent in each state (off, acquiring, relocking, locked at each output frequency) and how many register writes it took. Energy is then
+// time-in-state times the table's power for that state, plus a fixed energy per write.
+//
+// No per-cycle work: The meter is only told about state *transitions*, with their timestamp, and closes the previous interval then.
+// A PLL that sits locked for a simulated second costs exactly as much to account as one that sits locked for a nanosecond, and nothing
+// runs on the 100 MHz bus clock or on the output clock.
+//
+
+#ifndef PLL_POWER_H
+#define PLL_POWER_H
+
+
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+// The states of the lock state machine (`PllLockState`).
+#include "pll.h"
+
+
+
+// What is it: The power of the PLL in each state, as an electrical characteristics table would give it, and the energy of one register
+//             write. The power of a locked PLL grows with its output frequency (output divider and clock buffer switching), so it is
+//             a fixed part plus a part per MHz.
+struct PllPowerTable {
+    double off_mw;              // Leakage while disabled
+    double acquire_mw;          // Full acquisition after ENABLE (charge pump and VCO slewing)
+    double relock_mw;           // DFS relock
+    double locked_mw;           // Locked: fixed part
+    double locked_mw_per_mhz;   // Locked: per MHz of output frequency
+    double bus_write_pj;        // One register write
+
+    // The built-in values (see `pll_power.cpp`).
+    PllPowerTable();
+
+    // What is it: Loads a table from a text file of "<key> <value>" lines, with the field names above as keys and '#' comments. Keys
+    //             that are not in the file keep their current value. Returns `false` (and leaves the table unchanged) if the file
+    //             cannot be read or contains an unknown key or an unreadable value.
+    bool load(const std::string& path);
+};
+
+
+
+class PllPowerMeter {
+public:
+    PllPowerMeter();
+
+    // What is it: The state machine moved to 'next' at 'now_ps'. 'out_mhz' is the output frequency if 'next' is PLL_STATE_LOCKED.
+    void transition(PllLockState next, double out_mhz, uint64_t now_ps);
+
+    // What is it: The PLL accepted a register write.
+    void bus_write() { writes++; }
+
+    // What is it: Time spent in state 's' up to 'now_ps', including the interval still open.
+    uint64_t time_ps(PllLockState s, uint64_t now_ps) const;
+
+    // What is it: Total energy up to 'now_ps', in nanojoules (mW * us).
+    double energy_nj(const PllPowerTable& table, uint64_t now_ps) const;
+
+    // What is it: Prints the time in every state, the locked time per output frequency, the write count and the energy of each part.
+    void print(std::ostream& os, const std::string& name, const PllPowerTable& table, uint64_t now_ps) const;
+
+    uint64_t bus_writes() const { return writes; }
+
+private:
+    // Adds the interval [since_ps, now_ps) of the current state to 'ps' (a per-state array) and 'locked' (per output frequency).
+    void close(uint64_t now_ps, uint64_t* ps, std::map<double, uint64_t>& locked) const;
+
+    PllLockState               state;
+    double                     state_mhz;
+    uint64_t                   since_ps;
+    uint64_t                   state_ps[PLL_STATE_COUNT];
+    std::map<double, uint64_t> locked_ps;   // Locked time by output frequency (MHz). One entry per distinct frequency, not per lock.
+    uint64_t                   writes;
+};
+
+
+#endif // PLL_POWER_H
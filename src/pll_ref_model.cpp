@@ -0,0 +1,166 @@
+//
+// File: pll_ref_model.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the golden reference model declared in `pll_ref_model.h`. Every rule below is taken from the datasheet comments
+// and constants in `pll.h`, not from `pll.cpp`, so that a bug in the SystemC model does not silently become a bug in its checker.
+//
+
+#include "pll_ref_model.h"
+
+#include <cmath>
+#include <sstream>
+
+
+
+static const uint64_t PS_PER_NS = 1000;
+
+
+
+PllRefModel::PllRefModel() : has_analog(false) {
+    reset();
+}
+
+
+
+void PllRefModel::set_analog(const PllAnalogParams& params) {
+    analog     = params;
+    has_analog = true;
+}
+
+
+
+void PllRefModel::reset() {
+    n = m = od = 0;
+    frac = 0;
+    irq_status = 0;
+    irq_enable = PLL_IRQ_LOCK_DONE;
+    enable     = false;
+    dfs_enable = false;
+    locked     = false;
+    pending    = false;
+    due_ps     = 0;
+}
+
+
+
+// A new lock sequence always replaces the one in flight, and the PLL reports "not locked" until it completes.
+void PllRefModel::start_lock(uint64_t time_ps, uint64_t lock_ps) {
+    locked  = false;
+    pending = true;
+    due_ps  = time_ps + lock_ps;
+}
+
+
+
+void PllRefModel::write(uint32_t offset, uint32_t data, uint64_t time_ps) {
+
+    switch (offset) {
+        case PLL_REG_N_ADDR:
+            n = data & 0xFF;
+            break;
+
+        // Datasheet: with DFS enabled on a locked PLL, a change of M is a hop. Hops of up to PLL_DFS_MAX_STEP settle in
+        // BASE + PER_STEP * |step| ns; larger hops take a full acquisition.
+        case PLL_REG_M_ADDR: {
+            uint32_t new_m = data & 0xFF;
+            if (enable && dfs_enable && locked && new_m != m) {
+                uint32_t step = new_m > m ? new_m - m : m - new_m;
+                start_lock(time_ps, (step <= PLL_DFS_MAX_STEP ? PLL_DFS_SETTLE_BASE_NS + PLL_DFS_SETTLE_NS_PER_STEP * step
+                                                              : PLL_LOCK_TIME_NS) * PS_PER_NS);
+            }
+            m = new_m;
+            break;
+        }
+
+        case PLL_REG_OD_ADDR:
+            od = data & 0xFF;
+            break;
+
+        case PLL_REG_FRAC_ADDR:
+            frac = data & (PLL_FRAC_ONE - 1);
+            break;
+
+        // Datasheet: the lock sequence starts on the 0 -> 1 transition of ENABLE; clearing ENABLE stops the PLL. For a die with known
+        // analog parameters, the acquisition time is the lock-time model's, rounded to the picosecond as SystemC rounds it, and a die
+        // that cannot reach the target never locks.
+        case PLL_REG_CTRL_ADDR:
+            dfs_enable = (data & PLL_CTRL_DFS_EN) != 0;
+            if ((data & PLL_CTRL_ENABLE) != 0) {
+                if (!enable) {
+                    enable = true;
+                    if (!has_analog) {
+                        start_lock(time_ps, PLL_LOCK_TIME_NS * PS_PER_NS);
+                    } else {
+                        PllConfig     cfg = { int(m), int(n), int(od) };
+                        PllLockResult r   = pll_lock_model(analog, cfg);
+                        if (r.locks) {
+                            start_lock(time_ps, static_cast<uint64_t>(r.lock_ns * PS_PER_NS + 0.5));
+                        } else {
+                            locked  = false;
+                            pending = false;
+                        }
+                    }
+                }
+            } else {
+                enable  = false;
+                locked  = false;
+                pending = false;
+            }
+            break;
+
+        case PLL_REG_IRQ_STATUS_ADDR:
+            irq_status &= ~data;
+            break;
+
+        case PLL_REG_IRQ_ENABLE_ADDR:
+            irq_enable = data & 0xFF;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+
+double PllRefModel::expected_period_ns() const {
+    double f_out_mhz = (PLL_F_REF_MHZ * (m + double(frac) / PLL_FRAC_ONE)) / (n * od);
+    return 1000.0 / f_out_mhz;
+}
+
+
+
+std::string PllRefModel::check_lock(uint64_t time_ps, double period_ns) {
+
+    std::ostringstream err;
+
+    if (!pending) {
+        err << "unexpected lock at " << time_ps / PS_PER_NS << " ns (no lock sequence was started)";
+    } else if (time_ps != due_ps) {
+        err << "lock at " << time_ps / PS_PER_NS << " ns, expected at " << due_ps / PS_PER_NS << " ns";
+    } else {
+        // Both sides evaluate the same equation in double precision, so anything beyond rounding noise is a real difference. Degenerate
+        // dividers (N or OD of 0) give a non-finite frequency on both sides; those must agree in kind rather than in value.
+        double expected = expected_period_ns();
+        bool   same;
+        if (std::isfinite(expected) && std::isfinite(period_ns)) {
+            same = std::fabs(expected - period_ns) <= 1e-9 * std::fabs(expected);
+        } else {
+            same = std::isfinite(expected) == std::isfinite(period_ns);
+        }
+        if (!same) {
+            err << "output period " << period_ns << " ns, expected " << expected << " ns (N=" << n << " M=" << m << " OD=" << od
+                << " FRAC=" << frac << ")";
+        }
+    }
+
+    locked      = true;
+    pending     = false;
+    irq_status |= PLL_IRQ_LOCK_DONE;
+    return err.str();
+}
@@ -0,0 +1,80 @@
+//
+// File: pll_ref_model.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `PllRefModel`, the golden reference model of one PLL. It is written from the datasheet in `pll.h`, independently
+// of the SystemC model in `pll.cpp`, and is untimed plain C++: it is told about register writes (with the time they were sampled) and
+// answers "what should the PLL be doing now?": which registers hold what, whether a lock is due and when, and what output period the
+// frequency equation gives.
+//
+// The scoreboard (`pll_scoreboard.h`) feeds it the same transactions the DUT saw and compares every lock the DUT reports against it.
+//
+
+#ifndef PLL_REF_MODEL_H
+#define PLL_REF_MODEL_H
+
+
+
+#include <cstdint>
+#include <string>
+
+// The register map, control bits and lock timing constants: the specification the model is written against.
+#include "pll.h"
+
+// The lock-time model of a die with known analog parameters.
+#include "pll_lock_model.h"
+
+
+
+class PllRefModel {
+public:
+    PllRefModel();
+
+    // What is it: Returns the register file and the state machine to their reset values.
+    void reset();
+
+    // What is it: Models a die with these analog parameters instead of the fixed datasheet acquisition time. Survives `reset()`: the
+    //             parameters belong to the silicon, not to the register file.
+    void set_analog(const PllAnalogParams& params);
+
+    // What is it: Applies a register write to this PLL ('offset' within its window), sampled at 'time_ps'. It updates the register file
+    //             and, if the write starts a (re)lock, records when that lock is due.
+    void write(uint32_t offset, uint32_t data, uint64_t time_ps);
+
+    // What is it: Checks a lock reported by the DUT at 'time_ps' with output period 'period_ns'.
+    // Returns: An empty string if the lock matches the model, otherwise a description of the mismatch. Either way the model moves to
+    //          its locked state, so one error does not cascade into a flood of follow-on errors.
+    std::string check_lock(uint64_t time_ps, double period_ns);
+
+    // What is it: The output period the frequency equation predicts for the current dividers, in nanoseconds.
+    double expected_period_ns() const;
+
+    // What is it: `true` if a lock sequence is running and should complete at `lock_due_ps()`.
+    bool     lock_pending() const { return pending; }
+    uint64_t lock_due_ps()  const { return due_ps; }
+
+private:
+    void start_lock(uint64_t time_ps, uint64_t lock_ps);
+
+    // The die's analog parameters, if any.
+    PllAnalogParams analog;
+    bool            has_analog;
+
+    // The register file. Registers are 8 bits wide in the PLL, so writes are truncated exactly as `sc_uint<8>` truncates them.
+    uint32_t n, m, od, frac;
+    uint32_t irq_status, irq_enable;
+    bool     enable;
+    bool     dfs_enable;
+
+    // The lock state machine.
+    bool     locked;
+    bool     pending;
+    uint64_t due_ps;
+};
+
+
+#endif // PLL_REF_MODEL_H
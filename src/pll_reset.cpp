@@ -0,0 +1,125 @@
+//
+// File: pll_reset.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the reset controller declared in `pll_reset.h`.
+//
+
+#include "pll_reset.h"
+#include "pll_scoreboard.h"
+#include "pll_time.h"
+
+#include <algorithm>
+
+
+
+pll_reset_ctrl::pll_reset_ctrl(sc_module_name name, const std::vector<unsigned>& release)
+    : sc_module(name), num(release.size()), domain_reset("domain_reset", release.size()), release_cycles(release),
+      release_order(release.size()), num_assertions(release.size(), 0), scoreboard(NULL), releasing(false), release_cycle(0),
+      next_release(0), request_changed(release.size(), 0) {
+
+    for (unsigned d = 0; d < num; ++d) {
+        release_order[d] = d;
+    }
+    std::stable_sort(release_order.begin(), release_order.end(),
+                     [&](uint32_t a, uint32_t b) { return release_cycles[a] < release_cycles[b]; });
+
+    // Like the PMU's own reset output, every domain net starts released; the system reset edges are what the controller reacts to.
+    SC_METHOD(control_process);
+    sensitive << reset << request_event;
+    dont_initialize();
+}
+
+
+
+void pll_reset_ctrl::post_request(unsigned d, bool assert_reset) {
+    if (d >= num) {
+        return;     // No such domain, like a write outside every register window
+    }
+    requests.push_back(d);
+    request_assert.push_back(assert_reset ? 1 : 0);
+    request_event.notify(SC_ZERO_TIME);
+}
+
+
+
+// What is it: Drives the net of domain 'd', and returns whether that changed it. Writing the value it already has would not notify
+//             anything either, so it is neither written nor counted.
+bool pll_reset_ctrl::set_domain(unsigned d, bool value) {
+    if (domain_reset[d].read() == value) {
+        return false;
+    }
+    domain_reset[d].write(value);
+    if (value) {
+        num_assertions[d]++;
+    }
+    return true;
+}
+
+
+
+// How it works: Every activation first handles a system reset edge, then counts a clock edge of a release sequence and releases the domains
+//               that are due, then applies the per-domain requests if no sequence is running. A domain net written in this activation
+//               still reads its old value, so a second request for the same domain would overwrite the first in the same delta cycle
+//               and the first would never be seen: the requests from that one on are left queued for the next rising clock edge. While
+//               a sequence runs, or requests are left queued, the method waits for the next clock edge as well as for its static events;
+//               otherwise for its static events alone.
+void pll_reset_ctrl::control_process() {
+
+    if (reset.event()) {
+        if (reset.read() == true) {
+            for (unsigned d = 0; d < num; ++d) {
+                set_domain(d, true);
+            }
+            releasing = false;
+        } else {
+            releasing     = true;
+            release_cycle = 0;
+            next_release  = 0;
+        }
+    } else if (releasing && clk.posedge()) {
+        release_cycle++;
+    }
+
+    if (releasing) {
+        while (next_release < num && release_cycles[release_order[next_release]] <= release_cycle) {
+            set_domain(release_order[next_release], false);
+            next_release++;
+        }
+        releasing = next_release < num;
+    }
+
+    if (reset.read() == true || releasing) {
+        if (releasing) {
+            next_trigger(clk.posedge_event() | reset.value_changed_event() | request_event);
+        }
+        return;
+    }
+
+    std::fill(request_changed.begin(), request_changed.end(), 0);
+    size_t applied = 0;
+    for (; applied < requests.size(); ++applied) {
+        uint32_t d = requests[applied];
+        if (request_changed[d]) {
+            break;
+        }
+        bool assert_reset = request_assert[applied] != 0;
+        if (set_domain(d, assert_reset)) {
+            request_changed[d] = 1;
+            if (assert_reset && scoreboard != NULL) {
+                scoreboard->post_reset(sc_time_to_ps(sc_time_stamp()), d);
+            }
+        }
+    }
+    requests.erase(requests.begin(), requests.begin() + applied);
+    request_assert.erase(request_assert.begin(), request_assert.begin() + applied);
+
+    // The requests left queued wait for the clock edge alone: a new request in the meantime queues behind them.
+    if (!requests.empty()) {
+        next_trigger(clk.posedge_event() | reset.value_changed_event());
+    }
+}
@@ -0,0 +1,108 @@
+//
+// File: pll_reset.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `pll_reset_ctrl`, the reset distribution network of a multi-PLL system. The PMU's `reset` output used to be one
+// signal wired to the `reset` pin of every PLL: every edge of it woke the `bus_process` and `locking_process` of every instance, and there
+// was no way to reset one part of the system without resetting all of it.
+//
+// The controller takes the system reset as the root of a tree and drives one reset net per domain. A domain is a set of netlist groups
+// (`domain` statements in the netlist, see `pll_topology.h`), and every PLL of a group has its `reset` pin bound to its domain's net:
+//
+//   - One shared event per domain: A domain's net is one `sc_signal<bool>`, so asserting it notifies one event, and the only processes
+//     waiting for that event are the ones of the PLLs in the domain. Asserting or releasing one domain does not touch the others.
+//   - Release sequencing: The system reset asserts every domain in the same delta cycle. Its release is sequenced: every domain has a
+//     release delay in clock cycles, and is released that many rising clock edges after the system reset was (0, the default, releases
+//     it right away). Domains with the same delay are released together.
+//   - Per-domain reset: `assert_domain()` / `release_domain()` reset a single domain while the system runs. They may be called from any
+//     process; the controller applies them in its own process, which is the one writer of every domain net. Requests are applied in
+//     order, at most one change of a domain per activation: a request for a domain that already changed in the same activation (an
+//     assert and a release posted in the same delta cycle) waits, with the requests behind it, for the next rising clock edge, so every
+//     assertion holds its domain in reset for at least one clock edge and none is lost. Every per-domain assertion is posted to the
+//     scoreboard (`set_scoreboard()`), which resets the reference models of that domain's PLLs only.
+//
+// The controller has no process per domain and no clock sensitivity at all outside a release sequence: it wakes on a system reset edge,
+// on a per-domain request, and on the clock edges of a sequence until its last domain is released.
+//
+
+#ifndef PLL_RESET_H
+#define PLL_RESET_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+#include <vector>
+
+
+
+class PllScoreboard;
+
+
+SC_MODULE(pll_reset_ctrl) {
+
+    // The system clock (counted during a release sequence) and the system reset, the root of the tree.
+    sc_in<bool> clk;
+    sc_in<bool> reset;
+
+
+
+    // What is it: A controller for 'num_domains' domains. Domain `d` is released 'release_cycles[d]' rising clock edges after the system
+    //             reset.
+    pll_reset_ctrl(sc_module_name name, const std::vector<unsigned>& release_cycles);
+
+    SC_HAS_PROCESS(pll_reset_ctrl);
+
+
+
+    // What is it: The reset net of domain 'd', to bind the `reset` pins of its PLLs to.
+    sc_signal<bool>& domain(unsigned d) { return domain_reset[d]; }
+    unsigned         size() const       { return num; }
+
+    // What is it: Asserts / releases the reset of domain 'd' alone. The request takes effect in the next delta cycle. A request made
+    //             while the system reset is asserted or its release sequence is running waits until the sequence is over.
+    void assert_domain(unsigned d)  { post_request(d, true); }
+    void release_domain(unsigned d) { post_request(d, false); }
+
+    // What is it: The checker that is told about every per-domain assertion, NULL for none. The system reset is posted by the PMU.
+    void set_scoreboard(PllScoreboard* sb) { scoreboard = sb; }
+
+    // What is it: The number of times domain 'd' was asserted (by the system reset or on its own), for the report.
+    uint64_t assertions(unsigned d) const { return num_assertions[d]; }
+
+
+
+private:
+    unsigned                   num;
+    sc_vector<sc_signal<bool>> domain_reset;
+    std::vector<unsigned>      release_cycles;
+    std::vector<uint32_t>      release_order;      // Domain indices by release delay (stable: equal delays keep netlist order)
+    std::vector<uint64_t>      num_assertions;
+    PllScoreboard*             scoreboard;
+
+    // What is it: The release sequence in progress: the clock edges counted since the system reset was released, and the next domain
+    //             of `release_order` to release.
+    bool     releasing;
+    unsigned release_cycle;
+    size_t   next_release;
+
+    // What is it: The per-domain requests not applied yet, in order (domain, assert), and the event that wakes the controller for them.
+    std::vector<uint32_t> requests;
+    std::vector<uint8_t>  request_assert;
+    sc_event              request_event;
+
+    // What is it: The domains changed by a request in the current activation (see `control_process()`).
+    std::vector<uint8_t>  request_changed;
+
+    void post_request(unsigned d, bool assert_reset);
+    bool set_domain(unsigned d, bool value);
+    void control_process();
+};
+
+
+#endif // PLL_RESET_H
@@ -0,0 +1,449 @@
+//
+// File: pll_results.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the columnar results file declared in `pll_results.h`: the column encoders and decoders, the block layout and
+// the locked append.
+//
+
+#include "pll_results.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+
+
+// Column encodings, stored per column in the block.
+enum { ENC_RLE = 0, ENC_DELTA = 1, ENC_XOR = 2 };
+
+// What is it: The encoding of every column, by column id.
+static const uint8_t COLUMN_ENCODING[RC_COUNT] = {
+    ENC_DELTA, ENC_DELTA, ENC_RLE, ENC_RLE, ENC_DELTA, ENC_RLE, ENC_RLE, ENC_RLE,
+    ENC_XOR, ENC_XOR, ENC_XOR, ENC_XOR, ENC_DELTA, ENC_RLE
+};
+
+static const char* const COLUMN_NAME[RC_COUNT] = {
+    "run_id", "pll", "num_plls", "mode", "seed", "n", "m", "od",
+    "target_mhz", "achieved_mhz", "lock_ns", "wall_s", "delta_cycles", "pass"
+};
+
+static const size_t BLOCK_HEADER_BYTES = 20;
+
+
+
+static uint64_t bits_of(double d)   { uint64_t u; std::memcpy(&u, &d, sizeof(u)); return u; }
+static double   double_of(uint64_t u) { double d; std::memcpy(&d, &u, sizeof(d)); return d; }
+
+
+
+void PllResultsTable::append(const PllResultRow& r) {
+    cols[RC_RUN_ID].push_back(r.run_id);
+    cols[RC_PLL].push_back(r.pll);
+    cols[RC_NUM_PLLS].push_back(r.num_plls);
+    cols[RC_MODE].push_back(r.mode);
+    cols[RC_SEED].push_back(r.seed);
+    cols[RC_N].push_back(r.n);
+    cols[RC_M].push_back(r.m);
+    cols[RC_OD].push_back(r.od);
+    cols[RC_TARGET_MHZ].push_back(bits_of(r.target_mhz));
+    cols[RC_ACHIEVED_MHZ].push_back(bits_of(r.achieved_mhz));
+    cols[RC_LOCK_NS].push_back(bits_of(r.lock_ns));
+    cols[RC_WALL_S].push_back(bits_of(r.wall_s));
+    cols[RC_DELTA_CYCLES].push_back(r.delta_cycles);
+    cols[RC_PASS].push_back(r.pass ? 1 : 0);
+}
+
+
+
+PllResultRow PllResultsTable::row(size_t i) const {
+    PllResultRow r;
+    r.run_id       = cols[RC_RUN_ID][i];
+    r.pll          = cols[RC_PLL][i];
+    r.num_plls     = cols[RC_NUM_PLLS][i];
+    r.mode         = cols[RC_MODE][i];
+    r.seed         = cols[RC_SEED][i];
+    r.n            = cols[RC_N][i];
+    r.m            = cols[RC_M][i];
+    r.od           = cols[RC_OD][i];
+    r.target_mhz   = double_of(cols[RC_TARGET_MHZ][i]);
+    r.achieved_mhz = double_of(cols[RC_ACHIEVED_MHZ][i]);
+    r.lock_ns      = double_of(cols[RC_LOCK_NS][i]);
+    r.wall_s       = double_of(cols[RC_WALL_S][i]);
+    r.delta_cycles = cols[RC_DELTA_CYCLES][i];
+    r.pass         = cols[RC_PASS][i] != 0;
+    return r;
+}
+
+
+
+void PllResultsTable::clear() {
+    for (unsigned c = 0; c < RC_COUNT; ++c) {
+        cols[c].clear();
+    }
+}
+
+
+
+void PllResultsTable::print_csv(std::ostream& os) const {
+    for (unsigned c = 0; c < RC_COUNT; ++c) {
+        os << (c ? "," : "") << COLUMN_NAME[c];
+    }
+    os << "\n";
+    for (size_t i = 0; i < rows(); ++i) {
+        PllResultRow r = row(i);
+        os << r.run_id << "," << r.pll << "," << r.num_plls << "," << r.mode << "," << r.seed << ","
+           << r.n << "," << r.m << "," << r.od << "," << r.target_mhz << "," << r.achieved_mhz << "," << r.lock_ns << ","
+           << r.wall_s << "," << r.delta_cycles << "," << (r.pass ? 1 : 0) << "\n";
+    }
+}
+
+
+
+//================================================================================================================================
+// Encoding Primitives
+//================================================================================================================================
+
+static void put_varint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void put_le(std::vector<uint8_t>& out, uint64_t v, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+static uint64_t get_le(const uint8_t* p, unsigned bytes) {
+    uint64_t v = 0;
+    for (unsigned i = 0; i < bytes; ++i) {
+        v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return v;
+}
+
+
+
+// How it works: The standard reflected CRC-32 (polynomial 0xEDB88320, as in zlib and PNG), with the table built on first use.
+static uint32_t results_crc32(const uint8_t* p, size_t n) {
+    static uint32_t table[256];
+    static bool     ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        ready = true;
+    }
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; ++i) {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+
+
+//================================================================================================================================
+// Column Encoders and Decoders
+//================================================================================================================================
+
+static void encode_column(uint8_t enc, const std::vector<uint64_t>& v, std::vector<uint8_t>& out) {
+
+    if (enc == ENC_RLE) {
+        for (size_t i = 0; i < v.size(); ) {
+            size_t j = i + 1;
+            while (j < v.size() && v[j] == v[i]) {
+                j++;
+            }
+            put_varint(out, v[i]);
+            put_varint(out, j - i);
+            i = j;
+        }
+
+    } else if (enc == ENC_DELTA) {
+        uint64_t prev = 0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            int64_t d = static_cast<int64_t>(v[i] - prev);
+            put_varint(out, (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63));   // zigzag: small |d| -> small code
+            prev = v[i];
+        }
+
+    } else {
+        // One header byte: the number of zero bytes dropped at the low end (high nibble) and of bytes kept (low nibble).
+        uint64_t prev = 0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            uint64_t x = v[i] ^ prev;
+            unsigned low = 0, kept = 0;
+            if (x != 0) {
+                while (((x >> (8 * low)) & 0xFF) == 0) low++;
+                kept = 8 - low;
+                while (((x >> (8 * (low + kept - 1))) & 0xFF) == 0) kept--;
+            }
+            out.push_back(static_cast<uint8_t>((low << 4) | kept));
+            put_le(out, x >> (8 * low), kept);
+            prev = v[i];
+        }
+    }
+}
+
+
+
+static bool decode_column(uint8_t enc, const uint8_t* p, const uint8_t* end, size_t rows, std::vector<uint64_t>& v) {
+
+    size_t base = v.size();
+
+    if (enc == ENC_RLE) {
+        while (v.size() - base < rows) {
+            uint64_t value, run;
+            if (!get_varint(p, end, value) || !get_varint(p, end, run) || run > rows - (v.size() - base)) {
+                return false;
+            }
+            v.insert(v.end(), run, value);
+        }
+
+    } else if (enc == ENC_DELTA) {
+        uint64_t prev = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            uint64_t z;
+            if (!get_varint(p, end, z)) {
+                return false;
+            }
+            prev += (z >> 1) ^ (~(z & 1) + 1);   // un-zigzag
+            v.push_back(prev);
+        }
+
+    } else if (enc == ENC_XOR) {
+        uint64_t prev = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            if (p >= end) {
+                return false;
+            }
+            unsigned low = *p >> 4, kept = *p & 0x0F;
+            p++;
+            if (low + kept > 8 || end - p < static_cast<ptrdiff_t>(kept)) {
+                return false;
+            }
+            prev ^= (kept ? get_le(p, kept) << (8 * low) : 0);
+            p += kept;
+            v.push_back(prev);
+        }
+
+    } else {
+        return false;
+    }
+
+    return p == end;
+}
+
+
+
+//================================================================================================================================
+// Blocks and Files
+//================================================================================================================================
+
+bool append_results(const std::string& path, const PllResultsTable& table) {
+
+    if (table.rows() == 0) {
+        return true;
+    }
+
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> col;
+    for (unsigned c = 0; c < RC_COUNT; ++c) {
+        col.clear();
+        encode_column(COLUMN_ENCODING[c], table.cols[c], col);
+        payload.push_back(static_cast<uint8_t>(c));
+        payload.push_back(COLUMN_ENCODING[c]);
+        put_varint(payload, col.size());
+        payload.insert(payload.end(), col.begin(), col.end());
+    }
+
+    std::vector<uint8_t> block;
+    block.reserve(BLOCK_HEADER_BYTES + payload.size());
+    put_le(block, PLL_RESULTS_MAGIC, 4);
+    put_le(block, PLL_RESULTS_VERSION, 2);
+    put_le(block, RC_COUNT, 2);
+    put_le(block, table.rows(), 4);
+    put_le(block, payload.size(), 4);
+    put_le(block, results_crc32(payload.data(), payload.size()), 4);
+    block.insert(block.end(), payload.begin(), payload.end());
+
+#ifndef _WIN32
+    // O_APPEND moves every write to the current end of the file atomically; the lock keeps a block that needs more than one `write()`
+    // call (a full disk, a signal) from being split by another worker's block.
+    int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "RESULTS: Cannot open '" << path << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct flock lk;
+    std::memset(&lk, 0, sizeof(lk));
+    lk.l_type   = F_WRLCK;
+    lk.l_whence = SEEK_SET;
+    while (fcntl(fd, F_SETLKW, &lk) < 0 && errno == EINTR) {
+    }
+
+    bool ok = true;
+    for (size_t done = 0; done < block.size(); ) {
+        ssize_t n = ::write(fd, block.data() + done, block.size() - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            std::cerr << "RESULTS: Write to '" << path << "' failed: " << std::strerror(errno) << std::endl;
+            ok = false;
+            break;
+        }
+        done += n;
+    }
+
+    lk.l_type = F_UNLCK;
+    fcntl(fd, F_SETLK, &lk);
+    ::close(fd);
+    return ok;
+#else
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::app);
+    out.write(reinterpret_cast<const char*>(block.data()), block.size());
+    if (!out) {
+        std::cerr << "RESULTS: Write to '" << path << "' failed." << std::endl;
+        return false;
+    }
+    return true;
+#endif
+}
+
+
+
+// What is it: Checks and decodes the block at 'p' (before 'end') into 'blk', and sets 'block_bytes' to its size. Returns NULL, or what
+//             is wrong with the block. The columns are decoded into a copy, so that a bad column drops the whole block rather than leaving
+//             the columns of unequal length.
+static const char* decode_block(const uint8_t* p, const uint8_t* end, PllResultsTable& blk, size_t& block_bytes) {
+
+    if (end - p < static_cast<ptrdiff_t>(BLOCK_HEADER_BYTES) || get_le(p, 4) != PLL_RESULTS_MAGIC) {
+        return "no block header";
+    }
+    if (get_le(p + 4, 2) > PLL_RESULTS_VERSION) {
+        return "written by a newer version";
+    }
+    size_t rows  = get_le(p + 8, 4);
+    size_t bytes = get_le(p + 12, 4);
+    if (static_cast<size_t>(end - p) - BLOCK_HEADER_BYTES < bytes) {
+        return "truncated block";
+    }
+    if (results_crc32(p + BLOCK_HEADER_BYTES, bytes) != get_le(p + 16, 4)) {
+        return "checksum mismatch";
+    }
+
+    unsigned       ncols = static_cast<unsigned>(get_le(p + 6, 2));
+    const uint8_t* q     = p + BLOCK_HEADER_BYTES;
+    const uint8_t* qend  = q + bytes;
+    for (unsigned k = 0; k < ncols; ++k) {
+        uint64_t len;
+        if (qend - q < 2) {
+            return "bad column";
+        }
+        uint8_t id = q[0], enc = q[1];
+        q += 2;
+        if (!get_varint(q, qend, len) || len > static_cast<uint64_t>(qend - q)) {
+            return "bad column";
+        }
+        if (id < RC_COUNT && !decode_column(enc, q, q + len, rows, blk.cols[id])) {
+            return "bad column";
+        }
+        q += len;
+    }
+
+    for (unsigned c = 0; c < RC_COUNT; ++c) {
+        if (blk.cols[c].size() != rows) {
+            blk.cols[c].assign(rows, 0);   // Not in this file: an older writer
+        }
+    }
+    block_bytes = BLOCK_HEADER_BYTES + bytes;
+    return NULL;
+}
+
+
+
+// How it works: Blocks are read one after the other. A bad block (torn by a crash, or overwritten) does not end the read: the reader
+//               scans forward, byte by byte, for the next magic number that starts a block whose checksum is right, and carries on from
+//               there. The bytes skipped are reported, so a damaged file is never silently shorter.
+bool load_results(const std::string& path, PllResultsTable& table) {
+
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        std::cerr << "RESULTS: Cannot read '" << path << "'." << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    const uint8_t* p   = data.data();
+    const uint8_t* end = p + data.size();
+    unsigned blocks = 0;
+    size_t   skipped = 0;
+
+    while (p < end) {
+        PllResultsTable blk;
+        size_t          block_bytes = 0;
+        const char*     problem     = decode_block(p, end, blk, block_bytes);
+
+        if (problem != NULL) {
+            const uint8_t* bad = p;
+            for (p = bad + 1; p < end; ++p) {
+                if (end - p >= 4 && get_le(p, 4) == PLL_RESULTS_MAGIC) {
+                    blk = PllResultsTable();
+                    if (decode_block(p, end, blk, block_bytes) == NULL) {
+                        break;
+                    }
+                }
+            }
+            skipped += p - bad;
+            std::cerr << "RESULTS: '" << path << "': " << problem << " at byte " << (bad - data.data()) << "; skipped " << (p - bad)
+                      << " byte(s) to " << (p < end ? "the next valid block." : "the end of the file.") << std::endl;
+            if (p == end) {
+                break;
+            }
+        }
+
+        for (unsigned c = 0; c < RC_COUNT; ++c) {
+            table.cols[c].insert(table.cols[c].end(), blk.cols[c].begin(), blk.cols[c].end());
+        }
+        blocks++;
+        p += block_bytes;
+    }
+
+    if (skipped > 0) {
+        std::cerr << "RESULTS: '" << path << "': read " << blocks << " block(s), skipped " << skipped << " damaged byte(s)." << std::endl;
+    }
+    return blocks > 0 || data.empty();
+}
@@ -0,0 +1,111 @@
+//
+// File: pll_results.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the structured results output: one fixed-schema record per PLL per run (configuration, target and achieved
+// frequency, lock time, wall time, kernel activity, pass / fail), stored column by column in a compact binary file. A sweep of a million
+// runs is then analysed by loading the columns (`--results-dump` prints them as CSV), not by searching log text.
+//
+// File format: A results file is a sequence of self-contained blocks. Each block holds the rows of one flush (usually one run):
+//
+//     u32 magic "PLLR", u16 version, u16 number of columns, u32 number of rows, u32 payload bytes, u32 CRC-32 of the payload
+//     payload: per column: u8 column id, u8 encoding, varint byte count, encoded bytes
+//
+// Every column is compressed on its own, with the encoding that suits its content:
+//   - RLE:   (value, run length) pairs. Columns that are constant within a run or across a sweep (PLL count, mode, dividers, pass).
+//   - DELTA: zigzag varint of the difference to the previous row. Counters and ids (PLL index, run id, seed, delta cycles).
+//   - XOR:   the bits of a double XORed with the previous row's, with the zero bytes at both ends dropped (a byte-wise version of
+//            the Gorilla time-series encoding). Repeated values cost one byte, similar values a few.
+//
+// Multiple writers: Parallel sweep workers can append to the same file. Each block is written with a single `write()` on a file opened
+// in append mode, under an exclusive `fcntl` lock, so blocks never interleave. The CRC lets the reader detect a block torn by a crash
+// and skip it instead of returning garbage: it resynchronises on the next magic number whose block has a valid CRC.
+//
+
+#ifndef PLL_RESULTS_H
+#define PLL_RESULTS_H
+
+
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+
+#define PLL_RESULTS_MAGIC   0x524C4C50u   // "PLLR" in a little-endian file
+#define PLL_RESULTS_VERSION 1
+
+
+
+// What is it: The columns of the schema. The id of a column is its position here, and is stored in the file, so new columns are only
+//             ever added at the end. A reader ignores columns it does not know and fills columns a file does not have with zeros.
+enum PllResultColumn {
+    RC_RUN_ID,          // --run-id of the run (sweep bookkeeping)
+    RC_PLL,             // PLL index within the run
+    RC_NUM_PLLS,
+    RC_MODE,            // PmuTestMode
+    RC_SEED,
+    RC_N,               // Divider registers at the end of the run
+    RC_M,
+    RC_OD,
+    RC_TARGET_MHZ,      // Frequency the PMU configured for the initial lock
+    RC_ACHIEVED_MHZ,    // Output frequency at the end of the run (0 if not locked)
+    RC_LOCK_NS,         // Initial acquisition time, CTRL write to lock interrupt (0 if it never locked)
+    RC_WALL_S,          // Wall-clock time of the simulation
+    RC_DELTA_CYCLES,    // SystemC delta cycles of the simulation (process activation rounds)
+    RC_PASS,            // 1 if the PLL locked and was still locked at the end of the run
+    RC_COUNT
+};
+
+
+
+// What is it: One record, as the top level fills it in.
+struct PllResultRow {
+    uint64_t run_id;
+    uint64_t pll;
+    uint64_t num_plls;
+    uint64_t mode;
+    uint64_t seed;
+    uint64_t n, m, od;
+    double   target_mhz;
+    double   achieved_mhz;
+    double   lock_ns;
+    double   wall_s;
+    uint64_t delta_cycles;
+    bool     pass;
+};
+
+
+
+// What is it: Rows stored as columns, each as 64-bit words (doubles by their bit pattern), which is what the encoders work on.
+class PllResultsTable {
+public:
+    void     append(const PllResultRow& row);
+    PllResultRow row(size_t i) const;
+    size_t   rows() const { return cols[0].size(); }
+    void     clear();
+
+    // What is it: Prints the table as CSV with a header line.
+    void print_csv(std::ostream& os) const;
+
+    std::vector<uint64_t> cols[RC_COUNT];
+};
+
+
+
+// What is it: Appends the rows of 'table' to the results file at 'path' as one block, creating the file if needed. Safe against
+//             concurrent appends from other processes. Returns false (with a message) if the file cannot be written.
+bool append_results(const std::string& path, const PllResultsTable& table);
+
+// What is it: Reads every block of the file at 'path' and appends its rows to 'table'. A torn or corrupt block is skipped up to the next
+//             valid block, with a warning that gives the bytes skipped. Returns false if the file cannot be opened or has no valid block.
+bool load_results(const std::string& path, PllResultsTable& table);
+
+
+#endif // PLL_RESULTS_H
@@ -0,0 +1,222 @@
+//
+// File: pll_scoreboard.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the scoreboard declared in `pll_scoreboard.h`: the producer-side posting functions, the worker thread loop and
+// the end-of-run report.
+//
+
+#include "pll_scoreboard.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+
+
+// How many mismatch messages are kept for the report. A systematic bug produces thousands of identical errors; the first few say it all.
+static const unsigned MAX_REPORTED_ERRORS = 10;
+
+// How many consecutive empty polls the worker makes before it starts sleeping between polls. While the simulation is busy the queue is
+// rarely empty for long, so spinning briefly keeps latency low without burning a core during quiet phases.
+static const unsigned IDLE_SPINS = 256;
+
+
+
+PllScoreboard::PllScoreboard(unsigned num_plls, size_t queue_capacity)
+    : queue(queue_capacity), stop(false), running(false), producer_stalls(0),
+      models(num_plls), model_domain(num_plls, 0), writes_checked(0), locks_checked(0), errors(0) {
+}
+
+PllScoreboard::~PllScoreboard() {
+    if (running) {
+        stop.store(true, std::memory_order_release);
+        thread.join();
+    }
+}
+
+
+
+void PllScoreboard::set_analog_params(unsigned pll_index, const PllAnalogParams& params) {
+    if (pll_index < models.size()) {
+        models[pll_index].set_analog(params);
+    }
+}
+
+
+
+void PllScoreboard::set_reset_domains(const std::vector<uint32_t>& domain_of_pll) {
+    for (unsigned i = 0; i < models.size() && i < domain_of_pll.size(); ++i) {
+        model_domain[i] = domain_of_pll[i];
+    }
+}
+
+
+
+void PllScoreboard::start() {
+    running = true;
+    thread  = std::thread(&PllScoreboard::worker, this);
+}
+
+
+
+// What is it: Pushes one event, applying back-pressure if the worker has fallen a whole queue behind.
+// Why not drop: A dropped write would desynchronise the reference model and turn into a stream of false mismatches. Waiting is safe:
+//               the worker never waits for the producer, so it always makes progress.
+void PllScoreboard::push(const ScoreboardEvent& ev) {
+    if (queue.try_push(ev)) {
+        return;
+    }
+    producer_stalls++;
+    while (!queue.try_push(ev)) {
+        std::this_thread::yield();
+    }
+}
+
+void PllScoreboard::post_write(uint32_t addr, uint32_t data, uint64_t time_ps) {
+    ScoreboardEvent ev = { ScoreboardEvent::WRITE, addr, data, time_ps, 0.0 };
+    push(ev);
+}
+
+void PllScoreboard::post_lock(unsigned pll_index, uint64_t time_ps, double period_ns) {
+    ScoreboardEvent ev = { ScoreboardEvent::LOCK, pll_index, 0, time_ps, period_ns };
+    push(ev);
+}
+
+void PllScoreboard::post_reset(uint64_t time_ps, uint32_t domain) {
+    ScoreboardEvent ev = { ScoreboardEvent::RESET, domain, 0, time_ps, 0.0 };
+    push(ev);
+}
+
+
+
+//================================================================================================================================
+// Worker Thread
+//================================================================================================================================
+
+void PllScoreboard::worker() {
+
+    ScoreboardEvent ev;
+    unsigned idle = 0;
+
+    while (true) {
+        if (queue.try_pop(ev)) {
+            process(ev);
+            idle = 0;
+            continue;
+        }
+
+        // Only stop once the queue is empty *after* the stop flag was seen, so that nothing posted before `finish()` is lost.
+        if (stop.load(std::memory_order_acquire)) {
+            while (queue.try_pop(ev)) {
+                process(ev);
+            }
+            return;
+        }
+
+        if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+
+
+void PllScoreboard::mismatch(const std::string& what) {
+    errors++;
+    if (first_errors.size() < MAX_REPORTED_ERRORS) {
+        first_errors.push_back(what);
+    }
+}
+
+
+
+// What is it: Routes one event to the reference model of the PLL it concerns.
+// How it works: A write is decoded exactly as the datasheet describes (window = address / PLL_ADDR_WINDOW). Writes outside every
+//               window are legal bus traffic that no PLL responds to, so they are simply not modelled.
+void PllScoreboard::process(const ScoreboardEvent& ev) {
+
+    switch (ev.kind) {
+
+        case ScoreboardEvent::RESET:
+            for (unsigned i = 0; i < models.size(); ++i) {
+                if (ev.addr == SCOREBOARD_ALL_DOMAINS || model_domain[i] == ev.addr) {
+                    models[i].reset();
+                }
+            }
+            break;
+
+        case ScoreboardEvent::WRITE: {
+            uint32_t index = ev.addr / PLL_ADDR_WINDOW;
+            if (index < models.size()) {
+                models[index].write(ev.addr % PLL_ADDR_WINDOW, ev.data, ev.time_ps);
+                writes_checked++;
+            }
+            break;
+        }
+
+        case ScoreboardEvent::LOCK: {
+            locks_checked++;
+            if (ev.addr >= models.size()) {
+                std::ostringstream msg;
+                msg << "lock reported by unknown PLL " << ev.addr;
+                mismatch(msg.str());
+                break;
+            }
+            std::string err = models[ev.addr].check_lock(ev.time_ps, ev.period_ns);
+            if (!err.empty()) {
+                std::ostringstream msg;
+                msg << "PLL " << ev.addr << ": " << err;
+                mismatch(msg.str());
+            }
+            break;
+        }
+    }
+}
+
+
+
+//================================================================================================================================
+// End of Run
+//================================================================================================================================
+
+unsigned long PllScoreboard::finish(uint64_t end_ps) {
+
+    if (running) {
+        stop.store(true, std::memory_order_release);
+        thread.join();
+        running = false;
+    }
+
+    // The worker has been joined, so its state can now be read safely from this thread.
+    for (unsigned i = 0; i < models.size(); ++i) {
+        if (models[i].lock_pending() && models[i].lock_due_ps() <= end_ps) {
+            std::ostringstream msg;
+            msg << "PLL " << i << ": lock due at " << models[i].lock_due_ps() / 1000 << " ns was never reported";
+            mismatch(msg.str());
+        }
+    }
+
+    cout << "SCOREBOARD: " << writes_checked << " writes modelled, " << locks_checked << " locks checked";
+    if (producer_stalls > 0) {
+        cout << ", " << producer_stalls << " producer stalls";
+    }
+    cout << "." << endl;
+
+    if (errors == 0) {
+        cout << "SCOREBOARD: ✅ PASSED. Every lock matched the reference model." << endl;
+    } else {
+        cout << "SCOREBOARD: ❌ FAILED! " << errors << " mismatch(es) against the reference model:" << endl;
+        for (unsigned i = 0; i < first_errors.size(); ++i) {
+            cout << "  " << first_errors[i] << endl;
+        }
+    }
+
+    return errors;
+}
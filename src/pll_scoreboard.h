@@ -0,0 +1,107 @@
+//
+// File: pll_scoreboard.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares `PllScoreboard`, the self-checking part of the testbench. Until now the only check was "did `locked` go high
+// within 20 us?". The scoreboard checks *what* the PLL did: every register write the PMU sends is applied to a golden reference model
+// (`pll_ref_model.h`) of the addressed PLL, and every lock the PLL reports is compared against the model: was a lock due, is it on the
+// exact expected time, and is the output period the one the frequency equation gives?
+//
+// Off the simulation thread: Checking costs time, and with many PLLs it would all be spent inside the SystemC kernel thread, slowing the
+// simulation down. Instead, the producers (the PMU's bus driver and each PLL's lock logic) only copy a small event record into a lock-free
+// single-producer / single-consumer queue (`spsc_queue.h`), and a worker thread does the reference modelling and comparison in parallel.
+// All producers run on the SystemC kernel thread, so there really is a single producer. The worker never calls into SystemC.
+//
+
+#ifndef PLL_SCOREBOARD_H
+#define PLL_SCOREBOARD_H
+
+
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pll_ref_model.h"
+#include "spsc_queue.h"
+
+
+
+// What is it: The reset domain of a `post_reset()` that resets every PLL (the system reset).
+#define SCOREBOARD_ALL_DOMAINS  0xFFFFFFFFu
+
+
+
+// What is it: One observation, as it travels through the queue. Kept small and trivially copyable.
+struct ScoreboardEvent {
+    enum Kind { WRITE, LOCK, RESET };
+    Kind     kind;
+    uint32_t addr;        // WRITE: the full bus address. LOCK: the index of the PLL that locked. RESET: the reset domain.
+    uint32_t data;        // WRITE: the bus data.
+    uint64_t time_ps;     // When the PLL sampled the write / when it locked.
+    double   period_ns;   // LOCK: the output period the PLL reported.
+};
+
+
+
+class PllScoreboard {
+public:
+
+    // 'num_plls' reference models are created, one per PLL window starting at address 0. 'queue_capacity' bounds the memory in flight.
+    explicit PllScoreboard(unsigned num_plls, size_t queue_capacity = 1 << 16);
+    ~PllScoreboard();
+
+    // What is it: Tells the reference model of PLL 'pll_index' the analog parameters of its die (see `pll::set_analog_params()`).
+    //             Called before `start()`.
+    void set_analog_params(unsigned pll_index, const PllAnalogParams& params);
+
+    // What is it: The reset domain of every PLL, indexed by PLL (`PllTopology::domain_of()`), for the resets of a single domain. Without
+    //             it, every PLL is in domain 0. Called before `start()`.
+    void set_reset_domains(const std::vector<uint32_t>& domain_of_pll);
+
+    // What is it: Starts the worker thread. Called once, before `sc_start()`.
+    void start();
+
+    // What is it: The producer side, called from the SystemC kernel thread.
+    void post_write(uint32_t addr, uint32_t data, uint64_t time_ps);
+    void post_lock(unsigned pll_index, uint64_t time_ps, double period_ns);
+    void post_reset(uint64_t time_ps, uint32_t domain = SCOREBOARD_ALL_DOMAINS);
+
+    // What is it: Waits for the worker to drain the queue and stop, then checks for locks that were due by 'end_ps' but never reported,
+    //             and prints the result. Returns the number of mismatches found.
+    unsigned long finish(uint64_t end_ps);
+
+private:
+    PllScoreboard(const PllScoreboard&);
+    PllScoreboard& operator=(const PllScoreboard&);
+
+    void push(const ScoreboardEvent& ev);
+    void worker();
+    void process(const ScoreboardEvent& ev);
+    void mismatch(const std::string& what);
+
+    SpscQueue<ScoreboardEvent> queue;
+    std::thread                thread;
+    std::atomic<bool>          stop;
+    bool                       running;
+
+    // Producer-side statistics (only touched by the SystemC thread).
+    unsigned long producer_stalls;
+
+    // Worker-side state (only touched by the worker until `finish()` has joined it).
+    std::vector<PllRefModel> models;
+    std::vector<uint32_t>    model_domain;
+    unsigned long            writes_checked;
+    unsigned long            locks_checked;
+    unsigned long            errors;
+    std::vector<std::string> first_errors;   // Only the first few are kept and printed; the count covers all of them.
+};
+
+
+#endif // PLL_SCOREBOARD_H
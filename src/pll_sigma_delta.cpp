@@ -0,0 +1,157 @@
+//
+// File: pll_sigma_delta.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the MASH 1-1-1 modulator and the fractional-N clock view declared in `pll_sigma_delta.h`.
+//
+
+#include "pll_sigma_delta.h"
+
+#include <cmath>
+
+#include "philox.h"
+
+
+
+#define SDM_MASK  (PLL_FRAC_ONE - 1)
+
+
+
+PllSigmaDelta::PllSigmaDelta(uint32_t frac_in)
+    : frac(frac_in & SDM_MASK), acc1(0), acc2(0), acc3(0), c1(PLL_SDM_BLOCK, 0), c2(PLL_SDM_BLOCK + 2, 0), c3(PLL_SDM_BLOCK + 2, 0) {}
+
+
+
+// How it works: MASH 1-1-1. Each stage is a `PLL_FRAC_BITS`-bit accumulator fed with the residue of the stage before it; its carry is
+//               that stage's one-bit quantisation. The noise-cancellation network combines the carries as
+//                   y[k] = c1[k] + (c2[k] - c2[k-1]) + (c3[k] - 2 c3[k-1] + c3[k-2])
+//               which cancels the quantisation error of the first two stages and leaves that of the third, shaped by (1 - z^-1)^3.
+//               The accumulators are a recurrence and run one cycle at a time (pass 1, branch-free); the network has no dependency
+//               from one output to the next and runs over whole arrays (pass 2).
+void PllSigmaDelta::generate(int8_t* __restrict out, size_t n) {
+
+    while (n > 0) {
+        size_t len = n < PLL_SDM_BLOCK ? n : PLL_SDM_BLOCK;
+
+        // Pass 1: the accumulators. The carries go to c2[2 ..] and c3[2 ..], after the history of the previous chunk.
+        uint32_t a1 = acc1, a2 = acc2, a3 = acc3;
+        for (size_t k = 0; k < len; ++k) {
+            a1 += frac;
+            c1[k] = int8_t(a1 >> PLL_FRAC_BITS);
+            a1 &= SDM_MASK;
+            a2 += a1;
+            c2[k + 2] = int8_t(a2 >> PLL_FRAC_BITS);
+            a2 &= SDM_MASK;
+            a3 += a2;
+            c3[k + 2] = int8_t(a3 >> PLL_FRAC_BITS);
+            a3 &= SDM_MASK;
+        }
+        acc1 = a1; acc2 = a2; acc3 = a3;
+
+        // Pass 2: the noise-cancellation network, element by element. `out` and the carry arrays never overlap; saying so (`__restrict`)
+        // spares the compiler a run-time overlap check and a second, scalar copy of the loop.
+        const int8_t* __restrict p1 = c1.data();
+        const int8_t* __restrict p2 = c2.data();
+        const int8_t* __restrict p3 = c3.data();
+        #pragma omp simd
+        for (size_t k = 0; k < len; ++k) {
+            out[k] = int8_t(p1[k] + p2[k + 2] - p2[k + 1] + p3[k + 2] - 2 * p3[k + 1] + p3[k]);
+        }
+
+        // The last two carries are the history of the next chunk.
+        c2[0] = c2[len]; c2[1] = c2[len + 1];
+        c3[0] = c3[len]; c3[1] = c3[len + 1];
+
+        out += len;
+        n   -= len;
+    }
+}
+
+
+
+PllFracN::PllFracN() : n(1), m(0), od(1), frac(0), offsets(PLL_SDM_BLOCK, 0), inst_mhz(PLL_SDM_BLOCK, 0.0) {}
+
+
+
+void PllFracN::configure(unsigned n_in, unsigned m_in, uint32_t frac_in, unsigned od_in) {
+    n    = n_in;
+    m    = m_in;
+    od   = od_in;
+    frac = frac_in & SDM_MASK;
+    sdm  = PllSigmaDelta(frac);
+}
+
+
+
+double PllFracN::mean_mhz() const {
+    return PLL_F_REF_MHZ * (m + double(frac) / PLL_FRAC_ONE) / (n * od);
+}
+
+
+
+const double* PllFracN::next_block() {
+    sdm.generate(offsets.data(), PLL_SDM_BLOCK);
+    const double mhz_per_step = PLL_F_REF_MHZ / (n * od);
+    for (size_t k = 0; k < PLL_SDM_BLOCK; ++k) {
+        inst_mhz[k] = mhz_per_step * (int(m) + offsets[k]);
+    }
+    return inst_mhz.data();
+}
+
+
+
+// How it works: Reference cycle k moves the feedback edge by y[k] - FRAC / 2^24 VCO cycles against an ideal fractional divider, so the
+//               phase error is the running sum of that difference. Its spectrum is measured at the fractional spur (FRAC / 2^24 of the
+//               comparison frequency, folded into the first Nyquist zone) and its harmonics, with a Hann window. An amplitude of A VCO
+//               cycles is 2 pi A / OD radians of phase modulation at the output, a spur of 20 log10(2 pi A / OD / 2) dBc.
+std::vector<PllFracSpur> PllFracN::spurs(unsigned harmonics, unsigned blocks) const {
+
+    std::vector<PllFracSpur> lines;
+    if (frac == 0 || blocks == 0) {
+        return lines;
+    }
+
+    const size_t len  = size_t(blocks) * PLL_SDM_BLOCK;
+    const double mean = double(frac) / PLL_FRAC_ONE;
+
+    std::vector<int8_t> y(len);
+    PllSigmaDelta       local(frac);
+    local.generate(y.data(), len);
+
+    std::vector<double> phase(len);
+    double acc = 0.0, sum = 0.0;
+    for (size_t k = 0; k < len; ++k) {
+        acc     += y[k] - mean;
+        phase[k] = acc;
+        sum     += acc;
+    }
+    double dc = sum / len;
+
+    const double two_pi = PHILOX_TWO_PI;
+    const double f_pfd  = PLL_F_REF_MHZ / n;
+    for (unsigned h = 1; h <= harmonics; ++h) {
+        double x = std::fmod(h * mean, 1.0);
+        if (x > 0.5) {
+            x = 1.0 - x;
+        }
+        if (x <= 0.0) {
+            continue;
+        }
+        double re = 0.0, im = 0.0;
+        for (size_t k = 0; k < len; ++k) {
+            double w = 0.5 - 0.5 * std::cos(two_pi * k / (len - 1));
+            double v = (phase[k] - dc) * w;
+            re += v * std::cos(two_pi * x * k);
+            im -= v * std::sin(two_pi * x * k);
+        }
+        double amplitude = 2.0 * std::sqrt(re * re + im * im) / (0.5 * len);   // VCO cycles; 0.5 is the Hann coherent gain
+        double theta     = two_pi * amplitude / od;
+        PllFracSpur s = { x * f_pfd, theta > 0.0 ? 20.0 * std::log10(theta / 2.0) : -400.0 };
+        lines.push_back(s);
+    }
+    return lines;
+}
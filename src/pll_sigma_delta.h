@@ -0,0 +1,105 @@
+//
+// File: pll_sigma_delta.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the fractional-N part of the PLL: the sigma-delta modulator that dithers the feedback divider, and the view of
+// the resulting clock that downstream models use.
+//
+// In fractional-N mode (`PLL_REG_FRAC_ADDR` not 0) the feedback divider divides by M + y[k] in reference cycle k, where y[k] is the
+// output of a third-order MASH 1-1-1 modulator fed with FRAC. The average of y is exactly FRAC / 2^24, so the average output frequency is
+// F_ref * (M + FRAC / 2^24) / (N * OD); cycle by cycle it is not, and that difference is the quantisation noise (and, for some FRAC
+// values, the spurs) of a fractional-N PLL.
+//
+//   - `PllSigmaDelta`: The modulator. It generates the divider sequence in blocks, into a buffer the caller reuses, in two passes: a
+//     short sequential pass that runs the three accumulators and stores their carries, and a pass without any loop-carried dependency that
+//     combines them through the noise-cancellation network. That pass is marked `#pragma omp simd` and vectorises in every build
+//     configuration (the Makefile's `SIMD_FLAGS`), 16 outputs per SSE2 instruction.
+//   - `PllFracN`: The clock a fractional-N PLL delivers with given dividers: its exact mean frequency, its instantaneous frequency per
+//     reference cycle, generated block by block, and its spur content.
+//
+
+#ifndef PLL_SIGMA_DELTA_H
+#define PLL_SIGMA_DELTA_H
+
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The register map and `PLL_F_REF_MHZ`.
+#include "pll.h"
+
+
+
+// What is it: The number of reference cycles `PllFracN` generates per block.
+#define PLL_SDM_BLOCK  4096
+
+
+
+class PllSigmaDelta {
+public:
+
+    // What is it: A modulator with all accumulators cleared and a FRAC input of 'frac' (the low `PLL_FRAC_BITS` bits are used).
+    explicit PllSigmaDelta(uint32_t frac = 0);
+
+    // What is it: Writes the next 'n' divider offsets (-3 .. +4) to 'out'. Consecutive calls continue the same sequence. 'out' must not
+    //             point into the modulator itself (it never does: it is the caller's buffer).
+    void generate(int8_t* __restrict out, size_t n);
+
+private:
+    uint32_t frac;
+    uint32_t acc1, acc2, acc3;
+
+    // The carries of the three stages. The first two entries of `c2` and `c3` are the last two carries of the previous block, which the
+    // differentiators of the noise-cancellation network need.
+    std::vector<int8_t> c1, c2, c3;
+};
+
+
+
+// What is it: One spectral line of the fractional-N clock: its offset from the carrier and its level relative to the carrier.
+struct PllFracSpur {
+    double offset_mhz;
+    double dbc;
+};
+
+
+
+class PllFracN {
+public:
+    PllFracN();
+
+    // What is it: Sets the dividers and restarts the modulator.
+    void configure(unsigned n, unsigned m, uint32_t frac, unsigned od);
+
+    bool   fractional() const { return frac != 0; }
+    double mean_mhz() const;
+
+    // What is it: Generates the next `PLL_SDM_BLOCK` reference cycles. Returns the instantaneous output frequency in MHz of each, i.e. the
+    //             frequency the divider setting of that cycle calls for before the loop filter smooths it. The buffer is reused: the
+    //             values are valid until the next call.
+    const double* next_block();
+    const int8_t* block_offsets() const { return offsets.data(); }
+    size_t        block_size() const    { return PLL_SDM_BLOCK; }
+
+    // What is it: The fractional spur and its first 'harmonics' - 1 harmonics, measured on 'blocks' blocks of a separate modulator (the
+    //             sequence `next_block()` returns is not disturbed). The level is that of the phase modulation the divider sequence puts
+    //             on the output before the loop filter, i.e. the worst case; a real loop attenuates it by its transfer function at the
+    //             offset. Empty in integer mode.
+    std::vector<PllFracSpur> spurs(unsigned harmonics = 4, unsigned blocks = 16) const;
+
+private:
+    unsigned            n, m, od;
+    uint32_t            frac;
+    PllSigmaDelta       sdm;
+    std::vector<int8_t> offsets;
+    std::vector<double> inst_mhz;
+};
+
+
+#endif // PLL_SIGMA_DELTA_H
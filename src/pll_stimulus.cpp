@@ -0,0 +1,187 @@
+//
+// File: pll_stimulus.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the constrained-random stimulus generator declared in `pll_stimulus.h`.
+//
+// How constraints are solved: Instead of drawing (N, M, OD) freely and rejecting illegal triples (which wastes most draws and makes the
+// cost of a program unpredictable), the constructor precomputes, for every N, the exact range of M that keeps the VCO in band. A legal
+// program then draws N from the N values that have such a range, M uniformly inside it, and OD freely. Every draw is used.
+//
+
+#include "pll_stimulus.h"
+
+#include <cmath>
+
+
+
+// Cumulative weights (out of 100) of the scenario families. Most programs are legal; the corner cases are frequent enough that a sweep
+// of a few thousand programs hits every one of them many times.
+static const unsigned KIND_WEIGHTS[STIM_KIND_COUNT] = {
+    30,     // STIM_CANONICAL
+    50,     // STIM_REORDERED
+    60,     // STIM_CTRL_FIRST
+    75,     // STIM_ILLEGAL
+    90,     // STIM_DFS_HOP
+    100,    // STIM_ABORT
+};
+
+
+
+StimulusGenerator::StimulusGenerator(uint64_t seed) : stim_seed(seed), num_legal_n(0) {
+
+    for (int n = 0; n <= PLL_N_MAX; ++n) {
+        m_lo[n] = 1;
+        m_hi[n] = 0;
+    }
+
+    // VCO = F_ref * M / N must lie in [VCO_MIN, VCO_MAX], so M lies in [VCO_MIN * N / F_ref, VCO_MAX * N / F_ref], clipped to the M range.
+    for (int n = PLL_N_MIN; n <= PLL_N_MAX; ++n) {
+        int lo = static_cast<int>(std::ceil(PLL_VCO_MIN_MHZ * n / PLL_F_REF_MHZ));
+        int hi = static_cast<int>(std::floor(PLL_VCO_MAX_MHZ * n / PLL_F_REF_MHZ));
+        if (lo < PLL_M_MIN) lo = PLL_M_MIN;
+        if (hi > PLL_M_MAX) hi = PLL_M_MAX;
+        m_lo[n] = lo;
+        m_hi[n] = hi;
+        if (lo <= hi) {
+            legal_n[num_legal_n++] = n;
+        }
+    }
+}
+
+
+
+void StimulusGenerator::legal_config(PhiloxStream& rng, PllConfig& cfg) const {
+    cfg.n  = legal_n[rng.below(num_legal_n)];
+    cfg.m  = m_lo[cfg.n] + static_cast<int>(rng.below(m_hi[cfg.n] - m_lo[cfg.n] + 1));
+    cfg.od = PLL_OD_MIN + static_cast<int>(rng.below(PLL_OD_MAX - PLL_OD_MIN + 1));
+}
+
+
+
+// What is it: Starts from a legal configuration and breaks exactly one thing, so a failure points at one cause.
+// How it works: The corruptions are a zero divider (the classic divide-by-zero corner), a divider just above its maximum (one bit too
+//               wide for the datasheet, still fits the 8-bit register), and an M that puts the VCO just outside its band on either side.
+void StimulusGenerator::illegal_config(PhiloxStream& rng, PllConfig& cfg) const {
+
+    legal_config(rng, cfg);
+
+    switch (rng.below(6)) {
+        case 0: cfg.n  = 0;              break;
+        case 1: cfg.od = 0;              break;
+        case 2: cfg.n  = PLL_N_MAX + 1;  break;
+        case 3: cfg.od = PLL_OD_MAX + 1; break;
+        case 4: cfg.m  = m_lo[cfg.n] - 1; break;   // VCO just below its band (M may become 0 for the smallest N: also a corner)
+        default:
+            // VCO just above its band, if that is still a valid 8-bit M; otherwise M = 0.
+            cfg.m = (m_hi[cfg.n] < 255) ? m_hi[cfg.n] + 1 : 0;
+            break;
+    }
+}
+
+
+
+void StimulusGenerator::generate(uint64_t index, StimulusProgram& prog) const {
+
+    PhiloxStream rng(stim_seed, PHILOX_STREAM_STIMULUS, index);
+
+    unsigned roll = rng.below(100);
+    unsigned k = 0;
+    while (roll >= KIND_WEIGHTS[k]) ++k;
+    prog.kind = static_cast<StimulusKind>(k);
+
+    if (prog.kind == STIM_ILLEGAL) {
+        illegal_config(rng, prog.cfg);
+    } else {
+        legal_config(rng, prog.cfg);
+    }
+
+    prog.num_ops = 0;
+    StimulusOp* op = prog.ops;
+
+    #define STIM_WRITE(off, val) do { StimulusOp w = { StimulusOp::WRITE, (off), static_cast<uint32_t>(val) }; *op++ = w; } while (0)
+    #define STIM_WAIT()          do { StimulusOp w = { StimulusOp::WAIT_LOCK, 0, 0 }; *op++ = w; } while (0)
+
+    // Every program starts from a disabled PLL.
+    STIM_WRITE(PLL_REG_CTRL_ADDR, 0);
+
+    switch (prog.kind) {
+
+        case STIM_REORDERED: {
+            // A random permutation of the three divider writes (Fisher-Yates on three elements).
+            uint32_t order[3] = { PLL_REG_N_ADDR, PLL_REG_M_ADDR, PLL_REG_OD_ADDR };
+            for (unsigned i = 2; i > 0; --i) {
+                unsigned j = rng.below(i + 1);
+                uint32_t t = order[i]; order[i] = order[j]; order[j] = t;
+            }
+            for (unsigned i = 0; i < 3; ++i) {
+                uint32_t val = order[i] == PLL_REG_N_ADDR ? prog.cfg.n : order[i] == PLL_REG_M_ADDR ? prog.cfg.m : prog.cfg.od;
+                STIM_WRITE(order[i], val);
+            }
+            STIM_WRITE(PLL_REG_CTRL_ADDR, PLL_CTRL_ENABLE);
+            break;
+        }
+
+        case STIM_CTRL_FIRST:
+            STIM_WRITE(PLL_REG_CTRL_ADDR, PLL_CTRL_ENABLE);
+            STIM_WRITE(PLL_REG_N_ADDR,  prog.cfg.n);
+            STIM_WRITE(PLL_REG_M_ADDR,  prog.cfg.m);
+            STIM_WRITE(PLL_REG_OD_ADDR, prog.cfg.od);
+            break;
+
+        case STIM_DFS_HOP: {
+            // Lock first, then hop M by up to twice the fast-relock limit in either direction, staying inside the VCO band, so both
+            // the fast path and the full-relock fallback are exercised.
+            STIM_WRITE(PLL_REG_N_ADDR,  prog.cfg.n);
+            STIM_WRITE(PLL_REG_M_ADDR,  prog.cfg.m);
+            STIM_WRITE(PLL_REG_OD_ADDR, prog.cfg.od);
+            STIM_WRITE(PLL_REG_CTRL_ADDR, PLL_CTRL_ENABLE | PLL_CTRL_DFS_EN);
+            STIM_WAIT();
+            int step  = 1 + static_cast<int>(rng.below(2 * PLL_DFS_MAX_STEP));
+            int new_m = prog.cfg.m + ((rng.below(2) == 0) ? step : -step);
+            if (new_m < m_lo[prog.cfg.n]) new_m = m_lo[prog.cfg.n];
+            if (new_m > m_hi[prog.cfg.n]) new_m = m_hi[prog.cfg.n];
+            if (new_m == prog.cfg.m) new_m = (prog.cfg.m < m_hi[prog.cfg.n]) ? prog.cfg.m + 1 : prog.cfg.m - 1;
+            prog.cfg.m = new_m;
+            STIM_WRITE(PLL_REG_M_ADDR, new_m);
+            break;
+        }
+
+        case STIM_ABORT:
+            STIM_WRITE(PLL_REG_N_ADDR,  prog.cfg.n);
+            STIM_WRITE(PLL_REG_M_ADDR,  prog.cfg.m);
+            STIM_WRITE(PLL_REG_OD_ADDR, prog.cfg.od);
+            STIM_WRITE(PLL_REG_CTRL_ADDR, PLL_CTRL_ENABLE);
+            STIM_WRITE(PLL_REG_CTRL_ADDR, 0);
+            STIM_WRITE(PLL_REG_CTRL_ADDR, PLL_CTRL_ENABLE);
+            break;
+
+        case STIM_CANONICAL:
+        case STIM_ILLEGAL:
+        default:
+            STIM_WRITE(PLL_REG_N_ADDR,  prog.cfg.n);
+            STIM_WRITE(PLL_REG_M_ADDR,  prog.cfg.m);
+            STIM_WRITE(PLL_REG_OD_ADDR, prog.cfg.od);
+            STIM_WRITE(PLL_REG_CTRL_ADDR, PLL_CTRL_ENABLE);
+            break;
+    }
+
+    // Every program ends with a lock to wait for.
+    STIM_WAIT();
+
+    #undef STIM_WRITE
+    #undef STIM_WAIT
+
+    prog.num_ops = static_cast<unsigned>(op - prog.ops);
+}
+
+
+
+const char* StimulusGenerator::kind_name(StimulusKind kind) {
+    static const char* names[STIM_KIND_COUNT] = { "canonical", "reordered", "ctrl_first", "illegal", "dfs_hop", "abort" };
+    return kind < STIM_KIND_COUNT ? names[kind] : "unknown";
+}
@@ -0,0 +1,95 @@
+//
+// File: pll_stimulus.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the constrained-random stimulus generator for the PLL. Directed tests only exercise the orderings and values their
+// author thought of; the generator produces programming sequences nobody thought of, inside constraints that keep most of them legal:
+//
+//   - Legal programming:  N, M and OD inside their datasheet ranges *and* a VCO frequency (F_ref * M / N) inside the VCO band, written
+//                         in the canonical order or in a random order of the three dividers.
+//   - Corner cases:       CTRL written before the dividers, a lock aborted by clearing ENABLE and restarted, a DFS hop on a locked PLL,
+//                         and "illegal" programs with one divider out of range (including 0) or a VCO outside its band.
+//
+// Every program is a pure function of (seed, index), through the Philox counter-based generator (`philox.h`). A failing program from
+// a multi-million-program sweep is reproduced by running that one index with the same seed; nothing before it has to be replayed.
+//
+
+#ifndef PLL_STIMULUS_H
+#define PLL_STIMULUS_H
+
+
+
+#include <cstdint>
+
+#include "pll_divider.h"
+#include "philox.h"
+
+
+
+// What is it: One step of a programming sequence: a register write, or "wait for the lock interrupt before going on".
+struct StimulusOp {
+    enum Kind { WRITE, WAIT_LOCK };
+    Kind     kind;
+    uint32_t offset;   // WRITE: register offset within the PLL's window.
+    uint32_t data;     // WRITE: value.
+};
+
+
+
+// What is it: The scenario families the generator draws from. The weights are in `pll_stimulus.cpp`.
+enum StimulusKind {
+    STIM_CANONICAL,     // CTRL=0, N, M, OD, CTRL=EN
+    STIM_REORDERED,     // CTRL=0, the three dividers in a random order, CTRL=EN
+    STIM_CTRL_FIRST,    // CTRL=0, CTRL=EN, then the dividers while the PLL is already acquiring
+    STIM_ILLEGAL,       // canonical order, but one divider (or the VCO frequency) out of range
+    STIM_DFS_HOP,       // canonical programming with DFS enabled, lock, then a hop of M
+    STIM_ABORT,         // canonical programming, CTRL=0 in the middle of the lock, CTRL=EN again
+    STIM_KIND_COUNT
+};
+
+
+
+// What is it: One complete, self-contained programming sequence. It always starts by disabling the PLL, so it does not depend on what
+//             the previous program left behind, and it always ends with a lock to wait for.
+struct StimulusProgram {
+    static const unsigned MAX_OPS = 12;
+
+    StimulusKind kind;
+    PllConfig    cfg;             // The dividers the final lock uses.
+    unsigned     num_ops;
+    StimulusOp   ops[MAX_OPS];
+};
+
+
+
+class StimulusGenerator {
+public:
+    explicit StimulusGenerator(uint64_t seed);
+
+    // What is it: Builds program number 'index'. Costs one or two Philox blocks and no memory allocation.
+    void generate(uint64_t index, StimulusProgram& prog) const;
+
+    uint64_t seed() const { return stim_seed; }
+
+    static const char* kind_name(StimulusKind kind);
+
+private:
+    void legal_config(PhiloxStream& rng, PllConfig& cfg) const;
+    void illegal_config(PhiloxStream& rng, PllConfig& cfg) const;
+
+    uint64_t stim_seed;
+
+    // Precomputed constraint solution: for every N, the range of M that keeps the VCO inside its band. N values with an empty range
+    // (e.g. N = 16, where even M = 255 gives only 398 MHz) are never drawn for a legal program.
+    int m_lo[PLL_N_MAX + 1];
+    int m_hi[PLL_N_MAX + 1];
+    int legal_n[PLL_N_MAX + 1];
+    int num_legal_n;
+};
+
+
+#endif // PLL_STIMULUS_H
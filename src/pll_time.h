@@ -0,0 +1,31 @@
+//
+// File: pll_time.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header holds the conversion of SystemC time stamps to integer picoseconds, the time unit of the scoreboard events, the timer wheels,
+// the clock domains and the power meters. It used to live in `pll_scoreboard.h`, which made every module that only needed a time stamp
+// include the scoreboard, its reference model and its queue as well.
+//
+
+#ifndef PLL_TIME_H
+#define PLL_TIME_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+
+
+
+// What is it: Converts a SystemC time stamp to integer picoseconds. Integers make "exactly on time" checks exact.
+inline uint64_t sc_time_to_ps(const sc_time& t) {
+    return static_cast<uint64_t>(t.to_seconds() * 1e12 + 0.5);
+}
+
+
+#endif // PLL_TIME_H
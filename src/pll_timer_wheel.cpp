@@ -0,0 +1,155 @@
+//
+// File: pll_timer_wheel.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the hierarchical timer wheel declared in `pll_timer_wheel.h`.
+//
+
+#include "pll_timer_wheel.h"
+
+
+
+// The level a deadline belongs to relative to 'now': the base-64 digit of the highest bit in which they differ (0 if they are equal).
+static int wheel_level(uint64_t deadline_ps, uint64_t now_ps) {
+    uint64_t diff = deadline_ps ^ now_ps;
+    return diff == 0 ? 0 : (63 - __builtin_clzll(diff)) / PLL_WHEEL_BITS;
+}
+
+static unsigned wheel_digit(uint64_t t_ps, int level) {
+    return static_cast<unsigned>(t_ps >> (level * PLL_WHEEL_BITS)) & (PLL_WHEEL_SLOTS - 1);
+}
+
+
+
+PllTimerWheel::PllTimerWheel(unsigned capacity)
+    : now_ps(0), pending(0), deadline(capacity, 0), next(capacity, PLL_WHEEL_NIL), prev(capacity, PLL_WHEEL_NIL),
+      slot_of(capacity, PLL_WHEEL_NO_SLOT) {
+    for (int s = 0; s < PLL_WHEEL_LEVELS * PLL_WHEEL_SLOTS; ++s) {
+        head[s] = PLL_WHEEL_NIL;
+    }
+    for (int l = 0; l < PLL_WHEEL_LEVELS; ++l) {
+        occupied[l] = 0;
+    }
+}
+
+
+
+// What is it: Puts timer 'id' (not in any list) at the front of the slot its deadline belongs to, relative to the current time.
+void PllTimerWheel::link(unsigned id) {
+    int      level = wheel_level(deadline[id], now_ps);
+    unsigned digit = wheel_digit(deadline[id], level);
+    unsigned s     = level * PLL_WHEEL_SLOTS + digit;
+
+    prev[id] = PLL_WHEEL_NIL;
+    next[id] = head[s];
+    if (head[s] != PLL_WHEEL_NIL) {
+        prev[head[s]] = id;
+    }
+    head[s]          = id;
+    slot_of[id]      = static_cast<uint16_t>(s);
+    occupied[level] |= uint64_t(1) << digit;
+}
+
+
+
+void PllTimerWheel::unlink(unsigned id) {
+    unsigned s = slot_of[id];
+    if (prev[id] != PLL_WHEEL_NIL) {
+        next[prev[id]] = next[id];
+    } else {
+        head[s] = next[id];
+    }
+    if (next[id] != PLL_WHEEL_NIL) {
+        prev[next[id]] = prev[id];
+    }
+    if (head[s] == PLL_WHEEL_NIL) {
+        occupied[s / PLL_WHEEL_SLOTS] &= ~(uint64_t(1) << (s % PLL_WHEEL_SLOTS));
+    }
+    slot_of[id] = PLL_WHEEL_NO_SLOT;
+}
+
+
+
+void PllTimerWheel::schedule(unsigned id, uint64_t deadline_ps) {
+    if (armed(id)) {
+        unlink(id);
+    } else {
+        pending++;
+    }
+    deadline[id] = deadline_ps;
+    link(id);
+}
+
+
+
+void PllTimerWheel::cancel(unsigned id) {
+    if (armed(id)) {
+        unlink(id);
+        pending--;
+    }
+}
+
+
+
+// How it works: All timers of a level share the digits above it with `now`, and differ from it in their own digit, so a lower level holds
+//               only earlier deadlines than a higher one, and within a level a lower slot only earlier deadlines than a higher slot. The
+//               first slot of level 0 is one exact time; a slot of a higher level covers a range, and its list is searched.
+uint64_t PllTimerWheel::next_deadline() const {
+    for (int l = 0; l < PLL_WHEEL_LEVELS; ++l) {
+        if (occupied[l] == 0) {
+            continue;
+        }
+        unsigned digit = __builtin_ctzll(occupied[l]);
+        if (l == 0) {
+            return (now_ps & ~uint64_t(PLL_WHEEL_SLOTS - 1)) | digit;
+        }
+        uint64_t best = UINT64_MAX;
+        for (int32_t id = head[l * PLL_WHEEL_SLOTS + digit]; id != PLL_WHEEL_NIL; id = next[id]) {
+            if (deadline[id] < best) best = deadline[id];
+        }
+        return best;
+    }
+    return UINT64_MAX;
+}
+
+
+
+// How it works: Because nothing is due before 't_ps', every level whose higher digits change between the old and the new time is empty,
+//               and in every other level only the slot of the new time's digit holds timers that no longer belong there. Those are moved
+//               down, from the top level to the bottom, and the level-0 slot of 't_ps' is then exactly the set of timers due at 't_ps'.
+void PllTimerWheel::advance(uint64_t t_ps, std::vector<uint32_t>& fired) {
+
+    uint64_t old_ps = now_ps;
+    now_ps = t_ps;
+
+    for (int l = PLL_WHEEL_LEVELS - 1; l >= 1 && t_ps != old_ps; --l) {
+        unsigned digit = wheel_digit(t_ps, l);
+        if (digit == wheel_digit(old_ps, l) || !(occupied[l] & (uint64_t(1) << digit))) {
+            continue;
+        }
+        int32_t id = head[l * PLL_WHEEL_SLOTS + digit];
+        head[l * PLL_WHEEL_SLOTS + digit] = PLL_WHEEL_NIL;
+        occupied[l] &= ~(uint64_t(1) << digit);
+        while (id != PLL_WHEEL_NIL) {
+            int32_t after = next[id];
+            link(id);
+            id = after;
+        }
+    }
+
+    unsigned digit = wheel_digit(t_ps, 0);
+    if (!(occupied[0] & (uint64_t(1) << digit))) {
+        return;
+    }
+    for (int32_t id = head[digit]; id != PLL_WHEEL_NIL; id = next[id]) {
+        fired.push_back(id);
+        slot_of[id] = PLL_WHEEL_NO_SLOT;
+        pending--;
+    }
+    head[digit] = PLL_WHEEL_NIL;
+    occupied[0] &= ~(uint64_t(1) << digit);
+}
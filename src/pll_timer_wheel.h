@@ -0,0 +1,87 @@
+//
+// File: pll_timer_wheel.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the hierarchical timer wheel that holds the pending lock completions of a `pll_bank`, and of the standalone `pll`
+// modules through the shared `pll_lock_timer` (`pll_lock_timer.h`). Thousands of PLLs re-locking under DFS each have one deadline at a
+// time; instead of one kernel timer per PLL, the wheel keeps them all, its owner notifies one kernel event for the earliest, and every PLL
+// due at that instant is fired in one pass.
+//
+// How it works: Time is in picoseconds (the kernel's resolution). The wheel has `PLL_WHEEL_LEVELS` levels of `PLL_WHEEL_SLOTS` slots; level
+// L covers the time digit L in base 64. A timer is placed relative to the wheel's current time `now`: at the level of the highest digit in
+// which its deadline differs from `now`, in the slot of that digit of the deadline. So level 0 holds the timers of the current 64 ps, level
+// 1 those of the current 4 ns, and so on up to the whole 64-bit range, without an overflow list.
+//   - Advancing `now` to a new time only touches the one slot per level that the new time falls into: its timers move down to the level
+//     where they now belong ("cascading"). A timer cascades at most once per level over its lifetime.
+//   - The earliest deadline is in the first occupied slot of the lowest occupied level, found with one bit scan per level.
+//   - Every slot is an intrusive doubly linked list through arrays indexed by timer id, so scheduling and cancelling are O(1), without
+//     any allocation after construction.
+//
+
+#ifndef PLL_TIMER_WHEEL_H
+#define PLL_TIMER_WHEEL_H
+
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+#define PLL_WHEEL_BITS    6                          // Bits of time per level
+#define PLL_WHEEL_SLOTS   (1 << PLL_WHEEL_BITS)      // 64: one occupancy word per level
+#define PLL_WHEEL_LEVELS  11                         // 11 x 6 bits covers all 64 bits of a picosecond time
+#define PLL_WHEEL_NIL     (-1)                       // End of a slot list
+#define PLL_WHEEL_NO_SLOT 0xFFFF                     // `slot_of` of a timer that is not pending
+
+
+
+class PllTimerWheel {
+public:
+
+    // What is it: A wheel for the timer ids 0 .. 'capacity' - 1 (one per PLL), at time 0. Each id has at most one pending deadline.
+    explicit PllTimerWheel(unsigned capacity);
+
+    // What is it: Sets the deadline of timer 'id' to 'deadline_ps', which must not be before `now()`. A pending deadline of the same id is
+    //             replaced. O(1).
+    void schedule(unsigned id, uint64_t deadline_ps);
+
+    // What is it: Cancels the pending deadline of timer 'id', if any. O(1).
+    void cancel(unsigned id);
+
+    bool     armed(unsigned id) const { return slot_of[id] != PLL_WHEEL_NO_SLOT; }
+    bool     empty() const            { return pending == 0; }
+    size_t   size() const             { return pending; }
+    uint64_t now() const              { return now_ps; }
+
+    // What is it: The earliest pending deadline. The wheel must not be empty.
+    uint64_t next_deadline() const;
+
+    // What is it: Advances the wheel to 't_ps', which must not be after the earliest pending deadline, and appends the ids of every timer
+    //             due at 't_ps' to 'fired'. Those timers are no longer pending.
+    void advance(uint64_t t_ps, std::vector<uint32_t>& fired);
+
+private:
+    uint64_t now_ps;
+    size_t   pending;
+
+    // Per timer id: deadline, list links and the slot it is in (level * PLL_WHEEL_SLOTS + slot).
+    std::vector<uint64_t> deadline;
+    std::vector<int32_t>  next, prev;
+    std::vector<uint16_t> slot_of;
+
+    // Per slot: the first timer of its list. Per level: one bit per occupied slot.
+    int32_t  head[PLL_WHEEL_LEVELS * PLL_WHEEL_SLOTS];
+    uint64_t occupied[PLL_WHEEL_LEVELS];
+
+    void link(unsigned id);
+    void unlink(unsigned id);
+};
+
+
+#endif // PLL_TIMER_WHEEL_H
@@ -0,0 +1,291 @@
+//
+// File: pll_topology.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the netlist reader and the topology builder declared in `pll_topology.h`.
+//
+
+#include "pll_topology.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+
+
+// The arena is carved into the signal arrays and the module array, each starting at an offset aligned for its type.
+static size_t topology_align(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+
+
+// The limits of the numbers in a netlist. Windows are addressed on the 32-bit bus, so there are at most 2^32 / `PLL_ADDR_WINDOW` of
+// them, and no group or system can have more PLLs than that. A release delay of more than 2^24 cycles is a typo, not a reset sequence.
+#define NETLIST_MAX_WINDOWS         (0x100000000LL / PLL_ADDR_WINDOW)
+#define NETLIST_MAX_RELEASE_CYCLES  (1L << 24)
+
+
+
+// What is it: Parses a whole field as a number in [lo, hi] (decimal, or hex with 0x). `false` for trailing text, overflow or a value
+//             out of range, so a negative or huge number is never wrapped into an `unsigned`.
+static bool netlist_number(const std::string& text, long long lo, long long hi, unsigned& out) {
+    char* end = NULL;
+    errno = 0;
+    long long v = std::strtoll(text.c_str(), &end, 0);
+    if (end == text.c_str() || *end != '\0' || errno == ERANGE || v < lo || v > hi) {
+        return false;
+    }
+    out = static_cast<unsigned>(v);
+    return true;
+}
+
+
+
+PllNetlist PllNetlist::uniform(unsigned num_plls) {
+    PllNetlist net;
+    PllNetlistGroup  g = { "pll_inst", num_plls, 0, 0 };
+    PllNetlistDomain d = { "sys", 0 };
+    net.groups.push_back(g);
+    net.domains.push_back(d);
+    return net;
+}
+
+
+
+unsigned PllNetlist::size() const {
+    unsigned n = 0;
+    for (size_t g = 0; g < groups.size(); ++g) {
+        n += groups[g].count;
+    }
+    return n;
+}
+
+
+
+std::vector<unsigned> PllNetlist::release_cycles() const {
+    std::vector<unsigned> cycles(domains.size());
+    for (size_t d = 0; d < domains.size(); ++d) {
+        cycles[d] = domains[d].release_cycles;
+    }
+    return cycles;
+}
+
+
+
+bool PllNetlist::load(const std::string& path) {
+
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "NETLIST: Cannot read '" << path << "'." << std::endl;
+        return false;
+    }
+
+    PllNetlist net;
+    unsigned   next_window = 0;
+    long long  total       = 0;
+    std::string line;
+    unsigned line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        std::string::size_type hash = line.find('#');
+        if (hash != std::string::npos) {
+            line.erase(hash);
+        }
+
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) {
+            continue;   // blank or comment-only line
+        }
+
+        if (key == "clock") {
+            if (!(fields >> net.clock_period_ns) || net.clock_period_ns <= 0.0) {
+                std::cerr << "NETLIST: '" << path << "' line " << line_no << ": expected 'clock <period in ns>'." << std::endl;
+                return false;
+            }
+        } else if (key == "domain") {
+            PllNetlistDomain d;
+            d.release_cycles = 0;
+            if (!(fields >> d.name)) {
+                std::cerr << "NETLIST: '" << path << "' line " << line_no << ": expected 'domain <name> [<release cycles>]'." << std::endl;
+                return false;
+            }
+            std::string release;
+            if ((fields >> release) && !netlist_number(release, 0, NETLIST_MAX_RELEASE_CYCLES, d.release_cycles)) {
+                std::cerr << "NETLIST: '" << path << "' line " << line_no << ": bad release delay '" << release << "' (0 .. "
+                          << NETLIST_MAX_RELEASE_CYCLES << " cycles)." << std::endl;
+                return false;
+            }
+            for (size_t k = 0; k < net.domains.size(); ++k) {
+                if (net.domains[k].name == d.name) {
+                    std::cerr << "NETLIST: '" << path << "' line " << line_no << ": domain '" << d.name << "' is declared twice."
+                              << std::endl;
+                    return false;
+                }
+            }
+            net.domains.push_back(d);
+        } else if (key == "pll") {
+            PllNetlistGroup g;
+            std::string count;
+            if (!(fields >> g.name >> count)) {
+                std::cerr << "NETLIST: '" << path << "' line " << line_no << ": expected 'pll <name> <count> [<first window>]'."
+                          << std::endl;
+                return false;
+            }
+            if (!netlist_number(count, 1, NETLIST_MAX_WINDOWS - total, g.count)) {
+                std::cerr << "NETLIST: '" << path << "' line " << line_no << ": bad count '" << count << "' (1 .. "
+                          << NETLIST_MAX_WINDOWS - total << " PLLs left on the bus)." << std::endl;
+                return false;
+            }
+            g.first_window = next_window;
+            std::string window;
+            if ((fields >> window) && !netlist_number(window, 0, NETLIST_MAX_WINDOWS - g.count, g.first_window)) {
+                std::cerr << "NETLIST: '" << path << "' line " << line_no << ": bad window '" << window << "' (0 .. "
+                          << NETLIST_MAX_WINDOWS - g.count << " for " << g.count << " PLLs)." << std::endl;
+                return false;
+            }
+            for (size_t k = 0; k < net.groups.size(); ++k) {
+                if (net.groups[k].name == g.name) {
+                    std::cerr << "NETLIST: '" << path << "' line " << line_no << ": group '" << g.name << "' is declared twice."
+                              << std::endl;
+                    return false;
+                }
+            }
+            // Groups ahead of any `domain` statement are in an implicit domain released with the system reset.
+            if (net.domains.empty()) {
+                PllNetlistDomain sys = { "sys", 0 };
+                net.domains.push_back(sys);
+            }
+            g.domain    = net.domains.size() - 1;
+            next_window = g.first_window + g.count;
+            total      += g.count;
+            net.groups.push_back(g);
+        } else {
+            std::cerr << "NETLIST: '" << path << "' line " << line_no << ": unknown statement '" << key << "'." << std::endl;
+            return false;
+        }
+    }
+
+    // Every window 0 .. N-1 must be taken by exactly one instance.
+    unsigned n = net.size();
+    if (n == 0) {
+        std::cerr << "NETLIST: '" << path << "' has no PLLs." << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> taken(n, 0);
+    for (size_t g = 0; g < net.groups.size(); ++g) {
+        const PllNetlistGroup& grp = net.groups[g];
+        for (unsigned k = 0; k < grp.count; ++k) {
+            unsigned w = grp.first_window + k;
+            if (w >= n || taken[w]) {
+                std::cerr << "NETLIST: '" << path << "': group '" << grp.name << "' window " << w
+                          << (w >= n ? " is past the last PLL" : " is taken twice") << "; the windows must be 0 .. " << n - 1 << "."
+                          << std::endl;
+                return false;
+            }
+            taken[w] = 1;
+        }
+    }
+
+    *this = net;
+    return true;
+}
+
+
+
+// How it works: One allocation holds three arrays of N signals and, optionally, an array of N modules. Every object is constructed in
+//               place with its final name (generated into a stack buffer, not a `std::string` per object), in window order, so instance
+//               `i` of the topology is PLL `i` of the bus.
+PllTopology::PllTopology(const PllNetlist& netlist, bool build_modules)
+    : num(netlist.size()), arena(NULL), modules(NULL), locked_sigs(NULL), irq_sigs(NULL), clk_out_sigs(NULL), inst_domain(num, 0) {
+
+    size_t sig_bytes = sizeof(sc_signal<bool>) * num;
+    size_t off_sigs  = 0;
+    size_t off_mods  = topology_align(off_sigs + 3 * sig_bytes, alignof(pll));
+    size_t total     = build_modules ? off_mods + sizeof(pll) * num : off_mods;
+
+    arena = ::operator new(total);
+    unsigned char* base = static_cast<unsigned char*>(arena);
+    locked_sigs  = reinterpret_cast<sc_signal<bool>*>(base + off_sigs);
+    irq_sigs     = locked_sigs + num;
+    clk_out_sigs = irq_sigs + num;
+
+    char name[96];
+    for (unsigned i = 0; i < num; ++i) {
+        std::snprintf(name, sizeof(name), "locked_sig_%u", i);
+        new (&locked_sigs[i]) sc_signal<bool>(name);
+        std::snprintf(name, sizeof(name), "irq_sig_%u", i);
+        new (&irq_sigs[i]) sc_signal<bool>(name);
+        std::snprintf(name, sizeof(name), "clk_out_sig_%u", i);
+        new (&clk_out_sigs[i]) sc_signal<bool>(name);
+    }
+
+    for (size_t g = 0; g < netlist.groups.size(); ++g) {
+        for (unsigned k = 0; k < netlist.groups[g].count; ++k) {
+            inst_domain[netlist.groups[g].first_window + k] = netlist.groups[g].domain;
+        }
+    }
+
+    if (!build_modules) {
+        return;
+    }
+
+    modules = reinterpret_cast<pll*>(base + off_mods);
+    std::vector<const PllNetlistGroup*> owner(num);
+    std::vector<unsigned> index_in_group(num);
+    for (size_t g = 0; g < netlist.groups.size(); ++g) {
+        for (unsigned k = 0; k < netlist.groups[g].count; ++k) {
+            owner[netlist.groups[g].first_window + k]          = &netlist.groups[g];
+            index_in_group[netlist.groups[g].first_window + k] = k;
+        }
+    }
+    for (unsigned i = 0; i < num; ++i) {
+        if (index_in_group[i] == 0) {
+            std::snprintf(name, sizeof(name), "%s", owner[i]->name.c_str());
+        } else {
+            std::snprintf(name, sizeof(name), "%s_%u", owner[i]->name.c_str(), index_in_group[i]);
+        }
+        new (&modules[i]) pll(name);
+        modules[i].set_base_address(PLL_BASE_ADDR(i));
+    }
+}
+
+
+
+PllTopology::~PllTopology() {
+    for (unsigned i = num; modules != NULL && i-- > 0;) {
+        modules[i].~pll();
+    }
+    for (unsigned i = num; i-- > 0;) {
+        clk_out_sigs[i].~sc_signal<bool>();
+        irq_sigs[i].~sc_signal<bool>();
+        locked_sigs[i].~sc_signal<bool>();
+    }
+    ::operator delete(arena);
+}
+
+
+
+void PllTopology::bind(sc_signal_in_if<bool>& clk, pll_reset_ctrl& resets, sc_signal_in_if<sc_uint<32>>& bus_addr,
+                       sc_signal_in_if<sc_uint<32>>& bus_wdata, sc_signal_in_if<bool>& bus_we) {
+    for (unsigned i = 0; modules != NULL && i < num; ++i) {
+        pll& p = modules[i];
+        p.clk(clk);
+        p.reset(resets.domain(inst_domain[i]));
+        p.bus_addr(bus_addr);
+        p.bus_wdata(bus_wdata);
+        p.bus_we(bus_we);
+        p.locked(locked_sigs[i]);
+        p.irq(irq_sigs[i]);
+        p.clk_out(clk_out_sigs[i]);
+    }
+}
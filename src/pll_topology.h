@@ -0,0 +1,126 @@
+//
+// File: pll_topology.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares the topology builder: it elaborates the PLL side of a system from a compact netlist instead of one `new pll`, three
+// `sc_signal`s and nine port bindings per instance in `sc_main`.
+//
+//   - `PllNetlist`: The description. The system clock period, and groups of identical PLL instances, each with a name and the first
+//     register window it occupies. The clock, the reset and the bus fan out to every instance. A netlist is read from a small text file
+//     (`--netlist`), or made up of one group of `--plls` instances, which is what the simulator used to build by hand.
+//   - Reset domains: The groups are organised in reset domains, each with its own reset net driven by `pll_reset_ctrl` (`pll_reset.h`)
+//     and its own release delay. A netlist without `domain` statements is one domain, released with the system reset.
+//   - `PllTopology`: The elaborated system. All `pll` modules and their `locked`, `irq` and `clk_out` signals are constructed in place in
+//     one contiguous arena, sized once from the netlist, instead of being allocated one by one. The pins are bound in bulk: one pass over
+//     the instances binds the shared nets and each instance's own signals, and the PMU's interrupt vector is bound to the `irq` signals as
+//     a range.
+//
+// Netlist file format, one statement per line, '#' starts a comment:
+//     clock <period in ns>                      The system clock (default 10 ns).
+//     domain <name> [<release cycles>]          Starts a reset domain: the groups that follow, up to the next `domain`, are in it. It is
+//                                               released <release cycles> clock cycles after the system reset (default 0).
+//     pll <name> <count> [<first window>]       <count> instances named <name>, <name>_1, <name>_2, ... in consecutive register
+//                                               windows (`PLL_BASE_ADDR`), from <first window> (default: right after the previous group).
+// The windows of all groups must tile 0 .. N-1 without gaps or overlaps: the PMU addresses PLL `i` at window `i`. Group and domain names
+// must be unique, and the numbers must fit the bus: at most 2^32 / `PLL_ADDR_WINDOW` PLLs in all, release delays up to 2^24 cycles.
+//
+
+#ifndef PLL_TOPOLOGY_H
+#define PLL_TOPOLOGY_H
+
+
+
+#include <systemc.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pll.h"
+#include "pll_reset.h"
+
+
+
+// What is it: One group of identical PLL instances in consecutive register windows, and the index of its reset domain.
+struct PllNetlistGroup {
+    std::string name;
+    unsigned    count;
+    unsigned    first_window;
+    unsigned    domain;
+};
+
+
+
+// What is it: One reset domain and the number of clock cycles its release follows the system reset by.
+struct PllNetlistDomain {
+    std::string name;
+    unsigned    release_cycles;
+};
+
+
+
+struct PllNetlist {
+    double                        clock_period_ns;
+    std::vector<PllNetlistGroup>  groups;
+    std::vector<PllNetlistDomain> domains;
+
+    PllNetlist() : clock_period_ns(10.0) {}
+
+    // What is it: The netlist of 'num_plls' PLLs in one group, named like the simulator always named them ("pll_inst", "pll_inst_1", ...).
+    static PllNetlist uniform(unsigned num_plls);
+
+    // What is it: Reads a netlist file and checks that its windows tile 0 .. N-1. On an error, prints it and returns false, and the
+    //             netlist is unchanged.
+    bool load(const std::string& path);
+
+    // What is it: The total number of instances.
+    unsigned size() const;
+
+    // What is it: The release delay of every domain, indexed by domain, as `pll_reset_ctrl` takes them.
+    std::vector<unsigned> release_cycles() const;
+};
+
+
+
+class PllTopology {
+public:
+
+    // What is it: Constructs the signals of every PLL in the netlist, and the `pll` modules unless 'build_modules' is false (a `pll_bank`
+    //             then drives the signals). Must run during elaboration, like any module construction.
+    PllTopology(const PllNetlist& netlist, bool build_modules);
+    ~PllTopology();
+
+    // What is it: Binds the clock and the bus to every module, each module's `reset` to the net of its domain, and each module's pins to
+    //             its own signals, in one pass.
+    void bind(sc_signal_in_if<bool>& clk, pll_reset_ctrl& resets, sc_signal_in_if<sc_uint<32>>& bus_addr,
+              sc_signal_in_if<sc_uint<32>>& bus_wdata, sc_signal_in_if<bool>& bus_we);
+
+    unsigned size() const                   { return num; }
+    bool     has_modules() const            { return modules != NULL; }
+    unsigned domain_of(unsigned i) const    { return inst_domain[i]; }
+    pll&     instance(unsigned i)           { return modules[i]; }
+
+    // What is it: The signals of every PLL, each an array of `size()` entries, indexed by PLL.
+    sc_signal<bool>* locked_signals()       { return locked_sigs; }
+    sc_signal<bool>* irq_signals()          { return irq_sigs; }
+    sc_signal<bool>* clk_out_signals()      { return clk_out_sigs; }
+
+private:
+    unsigned              num;
+    void*                 arena;
+    pll*                  modules;
+    sc_signal<bool>*      locked_sigs;
+    sc_signal<bool>*      irq_sigs;
+    sc_signal<bool>*      clk_out_sigs;
+    std::vector<uint32_t> inst_domain;
+
+    PllTopology(const PllTopology&);
+    PllTopology& operator=(const PllTopology&);
+};
+
+
+#endif // PLL_TOPOLOGY_H
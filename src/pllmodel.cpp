@@ -0,0 +1,271 @@
+//
+// File: pllmodel.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the C interface of `libpllmodel` declared in `pllmodel.h`. The model is the same system `main.cpp` builds (one
+// `pmu_tb`, N `pll` instances on a shared bus, one `locked` and one `irq` line per PLL), without the options that only make sense for
+// a standalone run: VCD tracing, coverage and histogram files, the scoreboard and the Monte Carlo spot check.
+//
+
+#include "pllmodel.h"
+
+#include "systemc.h"
+#include "pll.h"
+#include "pll_lock_timer.h"
+#include "pll_time.h"
+#include "pmu_tb.h"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+
+// What is it: The model behind the opaque handle. Signals are members, so they live exactly as long as the modules bound to them.
+struct pllmodel {
+    pllmodel(unsigned n)
+        : clk("clk", 10, SC_NS), locked_sigs("locked_sig", n), irq_sigs("irq_sig", n), clk_out_sigs("clk_out_sig", n),
+          pmu(NULL), lock_timer(NULL), broken(false), dead(false) {
+    }
+
+    sc_clock                   clk;
+    sc_signal<bool>            reset_sig;
+    sc_signal<sc_uint<32>>     bus_addr_sig, bus_wdata_sig;
+    sc_signal<bool>            bus_we_sig;
+    sc_vector<sc_signal<bool>> locked_sigs;
+    sc_vector<sc_signal<bool>> irq_sigs;
+    sc_vector<sc_signal<bool>> clk_out_sigs;
+
+    pmu_tb*           pmu;
+    std::vector<pll*> plls;
+    pll_lock_timer*   lock_timer;
+    std::string       trace_path;
+    bool              broken;        // A kernel error was caught; the kernel state is undefined
+    bool              dead;          // `pllmodel_destroy()` was called
+};
+
+
+
+// What is it: Whether 'm' is a model the host may still use: not NULL, and not destroyed.
+static bool usable(const pllmodel* m) {
+    return m != NULL && !m->dead;
+}
+
+
+
+// SystemC has one kernel per process, and elaboration is over once it has run.
+static bool model_created = false;
+
+
+
+// libsystemc's own `main()` calls `sc_main()`. A host brings its own `main()` and never gets there, but the symbol still has to resolve
+// when libsystemc is a shared library. Weak, so that the real one in `main.cpp` wins when both are linked into `pll_sim`.
+extern "C" __attribute__((weak)) int sc_main(int, char*[]) {
+    std::cerr << "PLLMODEL: libpllmodel has no sc_main(); call the pllmodel_* functions from the host." << std::endl;
+    return 1;
+}
+
+
+
+void pllmodel_config_init(pllmodel_config* cfg) {
+    cfg->num_plls     = 1;
+    cfg->mode         = PLLMODEL_MODE_LOCK;
+    cfg->dfs_steps    = 10;
+    cfg->trace_path   = NULL;
+    cfg->seed         = 1;
+    cfg->random_start = 0;
+    cfg->random_count = 0;
+    cfg->clock_output = 0;
+    cfg->quiet        = 1;
+}
+
+
+
+// How it works: The same instantiation and binding as `sc_main()`, see `main.cpp` for the role of every connection. The PMU is told not
+//               to call `sc_stop()` at the end of its sequence, so that the host can go on stepping.
+pllmodel* pllmodel_create(const pllmodel_config* cfg) {
+
+    if (cfg == NULL || cfg->num_plls == 0) {
+        std::cerr << "PLLMODEL: No configuration, or zero PLLs." << std::endl;
+        return NULL;
+    }
+    if (cfg->mode == PLLMODEL_MODE_TRACE && cfg->trace_path == NULL) {
+        std::cerr << "PLLMODEL: Trace mode without a trace file." << std::endl;
+        return NULL;
+    }
+    if (model_created) {
+        std::cerr << "PLLMODEL: A model was already created in this process; SystemC allows only one." << std::endl;
+        return NULL;
+    }
+    model_created = true;
+
+    pll::verbose    = !cfg->quiet;
+    pmu_tb::verbose = !cfg->quiet;
+
+    pllmodel* m = NULL;
+    try {
+        m = new pllmodel(cfg->num_plls);
+
+        m->pmu = new pmu_tb("pmu_inst");
+        m->pmu->set_stop_at_end(false);
+        switch (cfg->mode) {
+        case PLLMODEL_MODE_DFS:
+            m->pmu->set_test_mode(PMU_TEST_DFS);
+            m->pmu->set_dfs_steps(cfg->dfs_steps);
+            break;
+        case PLLMODEL_MODE_TRACE:
+            m->trace_path = cfg->trace_path;
+            m->pmu->set_test_mode(PMU_TEST_TRACE);
+            m->pmu->set_trace_path(m->trace_path);
+            break;
+        case PLLMODEL_MODE_RANDOM:
+            m->pmu->set_test_mode(PMU_TEST_RANDOM);
+            m->pmu->set_random(cfg->seed, cfg->random_start, cfg->random_count);
+            break;
+        default:
+            break;
+        }
+
+        m->pmu->clk(m->clk);
+        m->pmu->reset(m->reset_sig);
+        m->pmu->bus_addr(m->bus_addr_sig);
+        m->pmu->bus_wdata(m->bus_wdata_sig);
+        m->pmu->bus_we(m->bus_we_sig);
+        m->pmu->pll_locked(m->locked_sigs[0]);
+        m->pmu->pll_irq.init(cfg->num_plls);
+        m->lock_timer = new pll_lock_timer("pll_lock_timer", cfg->num_plls);
+
+        for (unsigned i = 0; i < cfg->num_plls; ++i) {
+            std::string name = (i == 0) ? std::string("pll_inst") : "pll_inst_" + std::to_string(i);
+            pll* p = new pll(name.c_str());
+            m->plls.push_back(p);
+            m->lock_timer->attach(i, p);
+            p->set_base_address(PLL_BASE_ADDR(i));
+            p->set_clock_output(cfg->clock_output != 0);
+
+            p->clk(m->clk);
+            p->reset(m->reset_sig);
+            p->bus_addr(m->bus_addr_sig);
+            p->bus_wdata(m->bus_wdata_sig);
+            p->bus_we(m->bus_we_sig);
+            p->locked(m->locked_sigs[i]);
+            p->irq(m->irq_sigs[i]);
+            p->clk_out(m->clk_out_sigs[i]);
+            m->pmu->pll_irq[i](m->irq_sigs[i]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "PLLMODEL: Elaboration failed: " << e.what() << std::endl;
+        return NULL;   // Partly built modules stay registered with the kernel, so they are not deleted.
+    }
+
+    return m;
+}
+
+
+
+// How it works: `sc_start(duration)` runs the kernel for exactly that long and returns with time at the end of the window, whether or
+//               not anything was scheduled in it, so repeated calls keep the model in lockstep with the host's own time.
+int pllmodel_step_until(pllmodel* m, uint64_t time_ps) {
+
+    if (!usable(m)) {
+        return PLLMODEL_ERR_ARG;
+    }
+    if (m->broken) {
+        return PLLMODEL_ERR_KERNEL;
+    }
+
+    uint64_t now_ps = sc_time_to_ps(sc_time_stamp());
+    if (time_ps < now_ps) {
+        std::cerr << "PLLMODEL: Cannot step back to " << time_ps << " ps from " << now_ps << " ps." << std::endl;
+        return PLLMODEL_ERR_ARG;
+    }
+
+    if (time_ps > now_ps) {
+        try {
+            sc_start(sc_time(static_cast<double>(time_ps - now_ps), SC_PS));
+        } catch (const std::exception& e) {
+            std::cerr << "PLLMODEL: Simulation error at " << sc_time_stamp() << ": " << e.what() << std::endl;
+            m->broken = true;
+            return PLLMODEL_ERR_KERNEL;
+        }
+    }
+
+    return m->pmu->test_finished() ? PLLMODEL_FINISHED : PLLMODEL_OK;
+}
+
+
+
+// How it works: After `sc_start()`, the kernel's process tables, event queues and object hierarchy still point into the modules, and
+//               it walks them again when it is torn down at exit. Deleting the modules here would leave those pointers dangling, so the
+//               handle is only marked dead, and every later call with it is refused.
+void pllmodel_destroy(pllmodel* m) {
+    if (m != NULL) {
+        m->dead = true;
+    }
+}
+
+
+
+uint64_t pllmodel_time_ps(const pllmodel* m) {
+    return usable(m) ? sc_time_to_ps(sc_time_stamp()) : 0;
+}
+
+
+
+int pllmodel_finished(const pllmodel* m) {
+    return usable(m) && m->pmu->test_finished() ? 1 : 0;
+}
+
+
+
+unsigned pllmodel_num_plls(const pllmodel* m) {
+    return usable(m) ? static_cast<unsigned>(m->plls.size()) : 0;
+}
+
+
+
+int pllmodel_locked(const pllmodel* m, unsigned pll) {
+    if (!usable(m) || pll >= m->plls.size()) {
+        return PLLMODEL_ERR_ARG;
+    }
+    return m->locked_sigs[pll].read() ? 1 : 0;
+}
+
+
+
+int pllmodel_irq(const pllmodel* m, unsigned pll) {
+    if (!usable(m) || pll >= m->plls.size()) {
+        return PLLMODEL_ERR_ARG;
+    }
+    return m->irq_sigs[pll].read() ? 1 : 0;
+}
+
+
+
+uint64_t pllmodel_initial_lock_ps(const pllmodel* m, unsigned pll) {
+    if (!usable(m)) {
+        return 0;
+    }
+    const std::vector<sc_time>& t = m->pmu->initial_lock_times();
+    return pll < t.size() ? sc_time_to_ps(t[pll]) : 0;
+}
+
+
+
+int pllmodel_latency(const pllmodel* m, const char* name, double q, uint64_t* value_ns, uint64_t* count) {
+    if (!usable(m) || name == NULL) {
+        return PLLMODEL_ERR_ARG;
+    }
+    const LatencyHistogram* h = m->pmu->histogram(name);
+    if (h == NULL) {
+        return PLLMODEL_ERR_ARG;
+    }
+    if (value_ns) *value_ns = h->percentile(q);
+    if (count)    *count    = h->count();
+    return PLLMODEL_OK;
+}
@@ -0,0 +1,115 @@
+//
+// File: pllmodel.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header is the C interface of `libpllmodel`, the PLL system (the `pll` instances plus the `pmu_tb` sequencer) packaged as a library
+// for co-simulation hosts. Instead of running `bin/pll_sim` as a subprocess and parsing its stdout, a host (a C or C++ program, or
+// anything with a C foreign-function interface: Python ctypes, a Verilog DPI shim) links the library and drives the model in-process:
+//
+//     pllmodel_config cfg;
+//     pllmodel_config_init(&cfg);
+//     cfg.num_plls = 4;
+//     pllmodel* m = pllmodel_create(&cfg);
+//     while (pllmodel_step_until(m, t_ps += 1000000) == PLLMODEL_OK) {
+//         ... pllmodel_locked(m, 0) ...
+//     }
+//     pllmodel_destroy(m);
+//
+// One model per process: SystemC has a single, global simulation kernel, and modules can only be created before it first runs. So
+// `pllmodel_create()` succeeds once per process; after that (even after `pllmodel_destroy()`) it returns NULL. The kernel also keeps
+// pointers to the modules and their processes until the process exits, so `pllmodel_destroy()` cannot free them: it marks the handle
+// dead, and the model's memory is released when the host process exits.
+//
+// `pllmodel_host.c` is a complete host in C (create, step until every PLL has locked, query), built by `make lib`.
+//
+// Errors: Functions that can fail return a `PLLMODEL_ERR_*` code (or NULL) and print the reason to stderr, like the rest of the project.
+// No C++ exception ever crosses this interface.
+//
+
+#ifndef PLLMODEL_H
+#define PLLMODEL_H
+
+
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// The scenario the PMU sequencer runs. Same as `PmuTestMode` and the `pll_sim` options.
+#define PLLMODEL_MODE_LOCK    0   // Lock every PLL to 800 MHz
+#define PLLMODEL_MODE_DFS     1   // Then `dfs_steps` frequency changes (`--dfs`)
+#define PLLMODEL_MODE_TRACE   2   // Then replay `trace_path` on PLL 0 (`--trace`)
+#define PLLMODEL_MODE_RANDOM  3   // Then `random_count` constrained-random programs (`--random`)
+
+// Return codes.
+#define PLLMODEL_OK            0   // Success; for `pllmodel_step_until()`, the requested time was reached
+#define PLLMODEL_FINISHED      1   // The PMU sequence has ended; the model can still be stepped
+#define PLLMODEL_ERR_ARG      -1   // NULL or destroyed model, PLL index out of range, time in the past, unknown name
+#define PLLMODEL_ERR_KERNEL   -2   // The SystemC kernel reported an error; the model cannot be used any more
+
+
+
+typedef struct pllmodel pllmodel;   // Opaque
+
+
+
+// What is it: Everything that has to be fixed before elaboration. Start from `pllmodel_config_init()` and change what you need.
+typedef struct pllmodel_config {
+    unsigned    num_plls;         // PLL i is at PLL_BASE_ADDR(i). Default 1.
+    int         mode;             // PLLMODEL_MODE_*. Default PLLMODEL_MODE_LOCK.
+    int         dfs_steps;        // PLLMODEL_MODE_DFS. Default 10.
+    const char* trace_path;       // PLLMODEL_MODE_TRACE. Copied by `pllmodel_create()`.
+    uint64_t    seed;             // PLLMODEL_MODE_RANDOM. Default 1.
+    uint64_t    random_start;
+    uint64_t    random_count;
+    int         clock_output;     // Non-zero: generate `clk_out` edges (costs a process activation per edge). Default 0.
+    int         quiet;            // Non-zero: no per-transaction log lines. Default 1.
+} pllmodel_config;
+
+
+
+void pllmodel_config_init(pllmodel_config* cfg);
+
+// What is it: Builds and elaborates the model. Simulated time is 0 and nothing has run yet. NULL on error.
+pllmodel* pllmodel_create(const pllmodel_config* cfg);
+
+// What is it: Runs the simulation until simulated time 'time_ps' (absolute, picoseconds) and returns. PLLMODEL_OK, or PLLMODEL_FINISHED
+//             once the PMU sequence has ended (time still advances to 'time_ps'), or an error.
+int pllmodel_step_until(pllmodel* m, uint64_t time_ps);
+
+// What is it: Ends the use of the model. The handle is dead afterwards: every function given it fails (PLLMODEL_ERR_ARG, or 0 for the
+//             functions that return a count or a time). The modules are not deleted, because the kernel still refers to them; their
+//             memory goes with the process. No new model can be created afterwards.
+void pllmodel_destroy(pllmodel* m);
+
+
+
+// Queries. They read the state at the current simulated time and do not advance it.
+uint64_t pllmodel_time_ps(const pllmodel* m);
+int      pllmodel_finished(const pllmodel* m);                  // 1 once the PMU sequence has ended
+unsigned pllmodel_num_plls(const pllmodel* m);
+int      pllmodel_locked(const pllmodel* m, unsigned pll);      // 1 / 0, or PLLMODEL_ERR_ARG
+int      pllmodel_irq(const pllmodel* m, unsigned pll);         // 1 / 0, or PLLMODEL_ERR_ARG
+
+// What is it: The initial acquisition time (CTRL write to lock interrupt) of PLL 'pll' in picoseconds, or 0 if it has not locked yet.
+uint64_t pllmodel_initial_lock_ps(const pllmodel* m, unsigned pll);
+
+// What is it: Percentile 'q' (0..1) and sample count of one of the sequencer's latency histograms, in nanoseconds. 'name' is as printed
+//             in the report: "lock_from_first_write", "lock_from_ctrl_write", "relock", "bus_write". PLLMODEL_ERR_ARG if unknown.
+int pllmodel_latency(const pllmodel* m, const char* name, double q, uint64_t* value_ns, uint64_t* count);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PLLMODEL_H
@@ -0,0 +1,148 @@
+//
+// File: pmu_coro.cpp
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This file implements the coroutine scheduler declared in `pmu_coro.h`.
+//
+
+#include "pmu_coro.h"
+
+
+
+PmuCoroScheduler::PmuCoroScheduler(unsigned max_sequences, unsigned num_plls)
+    : capacity(max_sequences), num_live(0), current(PMU_CORO_NONE), num_resumes(0), edge_tick(0), num_lock_waits(0),
+      waiter_of(num_plls, PMU_CORO_NONE), check_listed(num_plls, 0), edge_wheel(max_sequences), time_wheel(max_sequences) {
+    handles.reserve(max_sequences);
+    lock_pll.reserve(max_sequences);
+    lock_deadline.reserve(max_sequences);
+    lock_ok.reserve(max_sequences);
+    check_list.reserve(num_plls);
+}
+
+
+
+PmuCoroScheduler::~PmuCoroScheduler() {
+    for (size_t s = 0; s < handles.size(); ++s) {
+        if (handles[s]) {
+            handles[s].destroy();
+        }
+    }
+}
+
+
+
+unsigned PmuCoroScheduler::spawn(PmuSequence seq) {
+    if (handles.size() == capacity || !seq.handle) {
+        return PMU_CORO_NONE;
+    }
+    unsigned id = handles.size();
+    handles.push_back(seq.handle);
+    seq.handle = nullptr;
+    lock_pll.push_back(PMU_CORO_NONE);
+    lock_deadline.push_back(0);
+    lock_ok.push_back(0);
+    ready.push_back(id);
+    num_live++;
+    return id;
+}
+
+
+
+// How it works: A resumed sequence runs until its next `co_await` (which files it under what it waits for) or its end (whose frame is
+//               freed here). Nothing a sequence does makes another one ready, so one pass over `ready` empties it.
+void PmuCoroScheduler::run_ready() {
+    for (size_t k = 0; k < ready.size(); ++k) {
+        current = ready[k];
+        num_resumes++;
+        handles[current].resume();
+        if (handles[current].done()) {
+            handles[current].destroy();
+            handles[current] = nullptr;
+            num_live--;
+        }
+    }
+    ready.clear();
+    current = PMU_CORO_NONE;
+}
+
+
+
+void PmuCoroScheduler::wait_edges(uint64_t n) {
+    edge_wheel.schedule(current, edge_tick + n);
+}
+
+
+
+// How it works: The wait takes the slot of its PLL, and the PLL is put on the check list once, in case its line is already up.
+void PmuCoroScheduler::wait_lock(unsigned pll, uint64_t timeout_ps) {
+    uint64_t deadline = sc_time_to_ps(sc_time_stamp()) + timeout_ps;
+    lock_pll[current]      = pll;
+    lock_deadline[current] = deadline;
+    waiter_of[pll]         = current;
+    num_lock_waits++;
+    time_wheel.schedule(current, deadline);
+    irq_raised(pll);
+}
+
+
+
+void PmuCoroScheduler::irq_raised(unsigned pll) {
+    if (waiter_of[pll] != PMU_CORO_NONE && !check_listed[pll]) {
+        check_listed[pll] = 1;
+        check_list.push_back(pll);
+    }
+}
+
+
+
+void PmuCoroScheduler::wait_bus(sc_uint<32> addr, sc_uint<32> data) {
+    PmuBusWrite w = { current, addr, data };
+    bus_queue.push_back(w);
+}
+
+
+
+void PmuCoroScheduler::resolve_lock(uint32_t seq, bool ok) {
+    waiter_of[lock_pll[seq]] = PMU_CORO_NONE;
+    num_lock_waits--;
+    lock_pll[seq] = PMU_CORO_NONE;
+    lock_ok[seq]  = ok ? 1 : 0;
+    ready.push_back(seq);
+}
+
+
+
+void PmuCoroScheduler::clock_edge() {
+    edge_tick++;
+    if (!edge_wheel.empty()) {
+        edge_wheel.advance(edge_tick, fired);
+        ready.insert(ready.end(), fired.begin(), fired.end());
+        fired.clear();
+    }
+}
+
+
+
+void PmuCoroScheduler::bus_done() {
+    ready.push_back(bus_queue.front().seq);
+    bus_queue.pop_front();
+}
+
+
+
+// How it works: The host may wake later than a deadline (e.g. at the end of a bus cycle), and the wheel can only be advanced up to its
+//               earliest deadline, so it is stepped from deadline to deadline until none is left that is not after 'now_ps'. A timed-out
+//               sequence gives up the slot of its PLL; if the PLL is still on the check list, the next poll finds no waiter and drops it.
+void PmuCoroScheduler::expire(uint64_t now_ps) {
+    while (!time_wheel.empty() && time_wheel.next_deadline() <= now_ps) {
+        time_wheel.advance(time_wheel.next_deadline(), fired);
+        for (size_t k = 0; k < fired.size(); ++k) {
+            resolve_lock(fired[k], false);
+        }
+        fired.clear();
+    }
+}
@@ -0,0 +1,240 @@
+//
+// File: pmu_coro.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header declares a stackless coroutine layer for PMU sequences, on top of SystemC events. `pmu_tb::run_test` is an `SC_THREAD`: it
+// has a stack of its own, and every `wait()` is a context switch into and out of it. That is right for one test host, but a system with
+// hundreds or thousands of power-management agents, one per domain, each running its own sequence of writes and waits, would need as many
+// threads and stacks.
+//
+// Here a sequence is a C++20 coroutine (`PmuSequence`). Its state lives in a frame the compiler sizes to what the sequence keeps across
+// suspensions (typically a few hundred bytes, not a stack), and resuming it is a function call. All sequences are run by one
+// `PmuCoroScheduler`, whose host is a single kernel process: the host tells the scheduler what happened (a clock edge, an interrupt, the
+// passing of time, a completed bus write), the scheduler resumes every sequence that can continue, and the host then waits for whatever
+// the suspended sequences need next.
+//
+// A sequence suspends on one of three awaitables:
+//   - `co_await sched.clock_edges(n)`:          Resume at the n-th clock edge from now.
+//   - `co_await sched.locked_or_timeout(i, t)`: Resume when PLL i raises its interrupt, or after 't'. The result is `true` on lock.
+//   - `co_await sched.bus_write(addr, data)`:   Resume when the host has performed the write (one bus cycle; writes are served in order).
+//
+// The edge and timeout waits are kept in two `PllTimerWheel`s (one counting clock edges, one in picoseconds), so suspending, resuming,
+// and cancelling a timeout when the lock arrives first, are O(1) whatever the number of sequences. A lock wait sits in the slot of its
+// PLL (one sequence per PLL at a time), and the host reports which interrupt lines rose, so resolving lock waits costs O(1) per rising
+// line, not a scan of every waiting sequence on every clock edge.
+//
+
+#ifndef PMU_CORO_H
+#define PMU_CORO_H
+
+
+
+#include <systemc.h>
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// `sc_time_to_ps()`.
+#include "pll_time.h"
+
+// The edge and timeout waits.
+#include "pll_timer_wheel.h"
+
+
+
+#define PMU_CORO_NONE 0xFFFFFFFFu      // No sequence / not waiting for any PLL
+
+
+
+class PmuCoroScheduler;
+
+
+
+// What is it: The return type of a PMU sequence coroutine. A function returning `PmuSequence` that contains `co_await` is a sequence;
+//             calling it only creates the (suspended) frame, and `PmuCoroScheduler::spawn()` takes it over and runs it.
+class PmuSequence {
+public:
+    struct promise_type {
+        PmuSequence         get_return_object()        { return PmuSequence(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept   { return {}; }
+        void                return_void()              {}
+        void                unhandled_exception()      { throw; }
+    };
+
+    PmuSequence(PmuSequence&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    PmuSequence(const PmuSequence&) = delete;
+    PmuSequence& operator=(const PmuSequence&) = delete;
+    ~PmuSequence() { if (handle) handle.destroy(); }
+
+private:
+    friend class PmuCoroScheduler;
+    explicit PmuSequence(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+
+
+// What is it: The three awaitables (see the description above). They only carry their arguments; suspending hands them to the scheduler.
+struct PmuEdgeWait {
+    PmuCoroScheduler* sched;
+    uint64_t          edges;
+
+    bool await_ready() const noexcept { return edges == 0; }
+    void await_suspend(std::coroutine_handle<>) const;
+    void await_resume() const noexcept {}
+};
+
+struct PmuLockWait {
+    PmuCoroScheduler* sched;
+    unsigned          pll;
+    uint64_t          timeout_ps;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const;
+    bool await_resume() const;
+};
+
+struct PmuBusWait {
+    PmuCoroScheduler* sched;
+    sc_uint<32>       addr;
+    sc_uint<32>       data;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const;
+    void await_resume() const noexcept {}
+};
+
+
+
+// What is it: One bus write requested by sequence 'seq'.
+struct PmuBusWrite {
+    uint32_t    seq;
+    sc_uint<32> addr;
+    sc_uint<32> data;
+};
+
+
+
+class PmuCoroScheduler {
+public:
+
+    // What is it: A scheduler for up to 'max_sequences' sequences, waiting for PLLs 0 .. 'num_plls' - 1.
+    PmuCoroScheduler(unsigned max_sequences, unsigned num_plls);
+    ~PmuCoroScheduler();
+
+    // What is it: Takes over a sequence, ready to run at the next `run_ready()`. Returns its id, or `PMU_CORO_NONE` (and destroys the
+    //             sequence) if the scheduler is full.
+    unsigned spawn(PmuSequence seq);
+
+    // What is it: The awaitables, for use inside the sequences.
+    PmuEdgeWait clock_edges(uint64_t n)                               { return PmuEdgeWait{ this, n }; }
+    PmuLockWait locked_or_timeout(unsigned pll, const sc_time& timeout) { return PmuLockWait{ this, pll, sc_time_to_ps(timeout) }; }
+    PmuBusWait  bus_write(sc_uint<32> addr, sc_uint<32> data)         { return PmuBusWait{ this, addr, data }; }
+
+
+
+    // === The host side ===
+
+    // What is it: Resumes every sequence that can continue, each until it suspends again or ends.
+    void run_ready();
+
+    // What is it: What the suspended sequences wait for. A host with `live()` sequences must wake on every clock edge while
+    //             `wants_edges()`, at `next_timeout_ps()` while `has_timeout()`, on any interrupt while `lock_waiters()`, and perform
+    //             `bus_front()` while `bus_pending()`. `locks_to_check()` is the number of PLLs the next `poll_locks()` looks at.
+    unsigned live() const                  { return num_live; }
+    bool     wants_edges() const           { return !edge_wheel.empty(); }
+    bool     has_timeout() const           { return !time_wheel.empty(); }
+    uint64_t next_timeout_ps() const       { return time_wheel.next_deadline(); }
+    unsigned lock_waiters() const          { return num_lock_waits; }
+    size_t   locks_to_check() const        { return check_list.size(); }
+    bool     bus_pending() const           { return !bus_queue.empty(); }
+    const PmuBusWrite& bus_front() const   { return bus_queue.front(); }
+
+    // What is it: The events, as the host reports them:
+    //   - `clock_edge()`: One clock edge passed. Edges the host does not report while nothing `wants_edges()` are simply not counted.
+    //   - `bus_done()`:   The DUT sampled `bus_front()`; its sequence continues.
+    //   - `irq_raised()`: The interrupt line of PLL 'pll' rose. Its lock wait, if any, is checked at the next `poll_locks()`.
+    //   - `poll_locks()`: Checks the lock waits of the PLLs reported by `irq_raised()` and of the waits that started since the last
+    //                     poll (the line may already be high), and resolves those for which 'is_locked(pll, deadline_ps)' is true,
+    //                     i.e. whose PLL has raised its interrupt no later than the wait's deadline. No other wait is looked at.
+    //   - `expire()`:     Times out every lock wait whose deadline is not after 'now_ps'. Call it after `poll_locks()`.
+    void clock_edge();
+    void bus_done();
+    void irq_raised(unsigned pll);
+    template <class IsLocked> void poll_locks(IsLocked is_locked);
+    void expire(uint64_t now_ps);
+
+    // What is it: The number of times a sequence was resumed, for the report of the host.
+    uint64_t resumes() const { return num_resumes; }
+
+
+
+    // === Used by the awaitables ===
+    void wait_edges(uint64_t n);
+    void wait_lock(unsigned pll, uint64_t timeout_ps);
+    void wait_bus(sc_uint<32> addr, sc_uint<32> data);
+    bool lock_result() const { return lock_ok[current] != 0; }
+
+private:
+    unsigned capacity;
+    unsigned num_live;
+    uint32_t current;                                // The sequence being resumed
+    uint64_t num_resumes;
+    uint64_t edge_tick;                              // Clock edges reported so far
+
+    unsigned num_lock_waits;
+
+    // Per sequence: its frame, the PLL it waits for (or `PMU_CORO_NONE`), and that wait's deadline and result.
+    std::vector<std::coroutine_handle<>> handles;
+    std::vector<uint32_t>                lock_pll;
+    std::vector<uint64_t>                lock_deadline;
+    std::vector<uint8_t>                 lock_ok;
+
+    // Per PLL: the sequence waiting for it (or `PMU_CORO_NONE`), and whether it is in `check_list`.
+    std::vector<uint32_t>                waiter_of;
+    std::vector<uint8_t>                 check_listed;
+
+    std::vector<uint32_t>   ready;                   // Sequences to resume in the next `run_ready()`
+    std::vector<uint32_t>   check_list;              // PLLs whose lock wait the next `poll_locks()` checks
+    std::vector<uint32_t>   fired;
+    std::deque<PmuBusWrite> bus_queue;
+    PllTimerWheel           edge_wheel;              // Deadlines in clock edges (`edge_tick`)
+    PllTimerWheel           time_wheel;              // Lock timeouts, in picoseconds
+
+    void resolve_lock(uint32_t seq, bool ok);
+};
+
+
+
+// How it works: A PLL whose line is not (or no longer) up to the wait is simply dropped from the list: its next rise reports it again.
+template <class IsLocked>
+void PmuCoroScheduler::poll_locks(IsLocked is_locked) {
+    for (size_t k = 0; k < check_list.size(); ++k) {
+        uint32_t p = check_list[k];
+        uint32_t s = waiter_of[p];
+        check_listed[p] = 0;
+        if (s != PMU_CORO_NONE && is_locked(p, lock_deadline[s])) {
+            time_wheel.cancel(s);
+            resolve_lock(s, true);
+        }
+    }
+    check_list.clear();
+}
+
+
+
+inline void PmuEdgeWait::await_suspend(std::coroutine_handle<>) const { sched->wait_edges(edges); }
+inline void PmuLockWait::await_suspend(std::coroutine_handle<>) const { sched->wait_lock(pll, timeout_ps); }
+inline bool PmuLockWait::await_resume() const                         { return sched->lock_result(); }
+inline void PmuBusWait::await_suspend(std::coroutine_handle<>) const  { sched->wait_bus(addr, data); }
+
+
+#endif // PMU_CORO_H
@@ -64,25 +64,63 @@
 #include "pll.h"
 
 
+// What is it: The divider solver, which also defines the `PllConfig` structure used to describe one set of (M, N, OD) divider values.
+// Why is it used here: The testbench has to turn a target frequency into register values, both for the directed test and for every
+//                   request of a replayed DVFS trace.
+#include "pll_divider.h"
 
 
+// What is it: The memory-mapped reader for recorded DVFS governor traces, used by the trace replay scenario.
+#include "dvfs_trace.h"
 
-//================================================================================================================================
-// C++ Concept: Data Structures (`struct`)
-//================================================================================================================================
-// What is it: This line declares a C++ `struct` named `PllConfig`. A struct (short for structure) is a composite data type that
-//             groups together variables of potentially different types under a single name. In this case, it groups three standard
-//             C++ `int` (integer) variables. By default, members of a struct are public.
-// Why is it used: While not used in the final implementation of my simple directed test case, I included this structure during my
-//               initial design phase. The intent was to create a clean, organized way to store a complete set of PLL configuration
-//               parameters (M, N, and OD dividers).
-// How it would be used: In a more advanced, coverage-driven verification scenario, I would use this struct to create objects representing
-//                    different test configurations. For example, a constrained-random test could generate a `PllConfig` object with
-//                    randomized (but legal) values for `m`, `n`, and `od`. This object could then be passed to a function to program
-//                    the PLL. This is a much cleaner and more scalable approach than passing multiple loose variables, and it's a
-//                    common practice in complex testbenches.
 
-struct PllConfig { int m; int n; int od; };
+// What is it: The constrained-random stimulus generator, used by the random scenario.
+#include "pll_stimulus.h"
+
+
+// What is it: The fixed-memory, log-bucketed latency histogram used to record lock, relock and bus latencies.
+#include "latency_histogram.h"
+
+
+// What is it: The scoreboard, which receives every bus write this testbench sends so its reference model sees the same stimulus as the DUT.
+#include "pll_scoreboard.h"
+
+
+// What is it: The stackless coroutine layer that runs the per-domain agents of the agents scenario inside this module's one thread.
+#include "pmu_coro.h"
+
+// What is it: The reset tree, whose per-domain requests the domain reset scenario drives.
+#include "pll_reset.h"
+
+
+// `std::vector` is used to keep track of which PLLs have already reported lock in a multi-PLL run.
+#include <vector>
+
+// `std::string` holds the path of the DVFS trace to replay.
+#include <string>
+
+
+
+
+
+// What is it: A C++ `enum` listing the test scenarios the PMU knows how to run.
+// Why is it used: The reset / program / wait-for-lock phases are common to every scenario, so rather than writing separate testbench
+//               modules we keep one `pmu_tb` and let the top level pick what happens after the initial lock. The values are:
+//   - `PMU_TEST_LOCK`: The original directed test. Program the PLL(s), check that they lock, stop.
+//   - `PMU_TEST_DFS`:  After the initial lock, switch PLL 0 into DFS mode and stream frequency steps at it, measuring every relock.
+//   - `PMU_TEST_TRACE`: After the initial lock, replay a recorded DVFS governor trace against PLL 0 and report lock-latency percentiles.
+//   - `PMU_TEST_RANDOM`: After the initial lock, run constrained-random programming sequences (see `pll_stimulus.h`) across the PLLs.
+//   - `PMU_TEST_AGENTS`: After the initial lock, run one power-management agent per PLL, all concurrently, each streaming DFS steps at
+//                       its own PLL (see `pmu_coro.h`).
+//   - `PMU_TEST_RESET`: After the initial lock, start a relock on every PLL and assert the system reset in the middle of it.
+//   - `PMU_TEST_DOMAIN_RESET`: After the initial lock, reset one reset domain while the others stay locked, and relock its PLLs.
+enum PmuTestMode { PMU_TEST_LOCK, PMU_TEST_DFS, PMU_TEST_TRACE, PMU_TEST_RANDOM, PMU_TEST_AGENTS, PMU_TEST_RESET, PMU_TEST_DOMAIN_RESET };
+
+
+
+// What is it: The output frequency the initial lock of every scenario programs. The top level needs it too, to predict the lock times
+//             of the Monte Carlo spot-check dies.
+#define PMU_TEST_TARGET_MHZ 800.0
 
 
 
@@ -139,6 +177,13 @@ SC_MODULE(pmu_tb) {
 
 
 
+    // `sc_vector<sc_in<bool>> pll_irq`: Declares one interrupt input per PLL in the system. An `sc_vector` is SystemC's container for a
+    // run-time-sized array of ports; its size is set by the top level with `pll_irq.init(n)` before the ports are bound. The number of
+    // entries is also how the testbench knows how many PLLs it has to configure (PLL `i` lives at `PLL_BASE_ADDR(i)`).
+    sc_vector<sc_in<bool>> pll_irq;
+
+
+
 //================================================================================================================================
 // OOP Concept: Data Encapsulation & Private Member Functions
 //================================================================================================================================
@@ -168,6 +213,157 @@ private:
 
 
 
+    // What is it: This declares the interrupt aggregator and the event it produces.
+    // Role in the project: `irq_aggregate_process` is an `SC_METHOD` that is sensitive to the rising edge of *every* `pll_irq` line and
+    //                    notifies the single `irq_event`. The test sequence therefore waits on one event, no matter whether one or
+    //                    sixty-four PLLs are locking in parallel, instead of waiting on each PLL's `locked` signal in turn.
+    void irq_aggregate_process();
+    sc_event irq_event;
+
+
+
+    // What is it: A helper that scans all interrupt lines, acknowledges every asserted one through the W1C status register and records
+    //             which PLLs have reported lock. It returns how many interrupts it serviced in this pass.
+    int service_irqs(std::vector<bool>& lock_seen);
+
+
+
+    // What is it: An override of the `sc_module` elaboration callback `before_end_of_elaboration()`.
+    // Why is it used: The sensitivity list of `irq_aggregate_process` depends on the size of `pll_irq`, which is only known after the
+    //               top level has called `pll_irq.init(n)`, i.e. after our constructor ran. SystemC allows processes to be registered
+    //               in this callback, which is the last moment before the design is frozen.
+    void before_end_of_elaboration() override;
+
+
+
+    // What is it: The DFS scenario. It is called by `run_test` once the initial lock has been confirmed.
+    // Role in the project: It acts like a power-management governor: it writes a stream of new M values to a running PLL and measures,
+    //                    for every step, the latency from the M write to the lock-done interrupt. This is the number a DFS governor
+    //                    policy is judged by.
+    void run_dfs_sequence(int start_m);
+
+
+
+    // What is it: A helper that waits for the interrupt of one specific PLL (or a timeout), then acknowledges it.
+    // Returns: `true` if the interrupt arrived in time, and the time at which it arrived in `irq_time` (measured before the
+    //          acknowledge write, so the one-cycle bus write does not pollute latency numbers). Used by the sequences that talk to a
+    //          single PLL at a time.
+    bool wait_for_lock_irq(unsigned pll_index, const sc_time& timeout, sc_time& irq_time);
+
+
+
+    // What is it: The trace replay scenario. It is called by `run_test` once the initial lock has been confirmed.
+    // Role in the project: It streams a recorded governor trace (see `dvfs_trace.h`) through the divider solver and onto PLL 0, at the
+    //                    simulated times recorded in the trace, and reports p50 / p99 / max lock latency plus how much faster than
+    //                    real time the replay ran. 'start' is the configuration PLL 0 is locked at when the replay begins.
+    void run_trace_replay(const PllConfig& start);
+
+
+
+    // What is it: The constrained-random scenario. It runs programs [random_start, random_start + random_count) of the generator seeded
+    //             with `random_seed`, program `k` on PLL `k % num_plls`, and waits for the lock after each. The scoreboard and coverage
+    //             collector do the checking and the accounting; this sequence only reports programs that never locked.
+    void run_random_sequence();
+
+
+
+    // What is it: The agents scenario. `run_agent_sequences` hosts one `agent_sequence` coroutine per PLL on a `PmuCoroScheduler` and
+    //             serves what they wait for (bus writes, clock edges, interrupts, timeouts) from the `run_test` thread, so thousands of
+    //             agents cost one kernel process. Each agent enables DFS on its PLL and issues `agent_steps` frequency steps, dwelling a
+    //             domain-specific number of clock cycles at each.
+    void        run_agent_sequences(int start_m);
+
+
+
+    // What is it: The reset scenario. Every PLL is sent an oversized DFS hop from 'start_m', which takes a full-length relock, and the
+    //             system reset is asserted while the relocks are in progress. A PLL must come out of the reset switched off: no lock,
+    //             no interrupt, even after the time the interrupted relock would have taken. The top level checks the internal state.
+    void        run_reset_sequence(int start_m);
+
+    // What is it: The domain reset scenario. The reset of one domain is asserted and released in the same delta cycle, which the reset
+    //             tree must stretch to a clock edge rather than drop, and its PLLs are then programmed again with 'cfg' and must relock.
+    //             No PLL of another domain may raise an interrupt; the top level checks that none of them was even woken.
+    void        run_domain_reset_sequence(const PllConfig& cfg);
+    pll_reset_ctrl*       reset_tree;
+    unsigned              reset_domain;
+    std::vector<uint32_t> domain_of_pll;
+    sc_time               domain_reset_time;
+    PmuSequence agent_sequence(unsigned pll_index, int start_m);
+
+    PmuCoroScheduler*     agents;
+    std::vector<unsigned> irq_rose;         // Lines that rose since the agents' host last looked (see `irq_aggregate_process`)
+    int                   agent_steps;
+    uint64_t              agent_relocks;
+    uint64_t              agent_failures;
+
+
+
+    // What is it: The latency histograms of the run, all in nanoseconds. They are printed (and optionally saved for merging with other
+    //             runs) at the end of `run_test`:
+    //   - `hist_lock`:   From the first register write to a PLL until its lock interrupt (the full "program and lock" time).
+    //   - `hist_ctrl`:   From the CTRL write that enabled a PLL until its lock interrupt (the PLL's own acquisition time).
+    //   - `hist_relock`: From a frequency-change write until the lock interrupt, in the DFS and trace replay scenarios.
+    //   - `hist_bus`:    The duration of every `write_to_pll` bus transaction, from the call until the PLL sampled it.
+    LatencyHistogram hist_lock;
+    LatencyHistogram hist_ctrl;
+    LatencyHistogram hist_relock;
+    LatencyHistogram hist_bus;
+    std::string      hist_out_path;
+
+
+
+    // What is it: The scoreboard that every bus write and reset is posted to, or NULL if checking is off.
+    PllScoreboard*   scoreboard;
+
+
+
+    // What is it: The time at which each interrupt line last rose, captured by `irq_aggregate_process`.
+    // Why is it used: The service loop may only get to a PLL after acknowledging others, a few bus cycles later. Lock latencies are taken
+    //               from this timestamp, so they measure the PLL rather than the PMU's queueing.
+    std::vector<sc_time> irq_rise_time;
+
+
+
+    // What is it: The acquisition time (CTRL write to lock interrupt) each PLL took in the initial lock, or `SC_ZERO_TIME` if it never
+    //             locked. Read by the top level after the run.
+    std::vector<sc_time> initial_lock_time;
+
+
+
+    // What is it: Prints every non-empty histogram and, if a path was given, saves them all for later merging.
+    void report_histograms();
+
+
+
+    // What is it: The scenario selected by the top level, the number of DFS steps to issue in `PMU_TEST_DFS` mode, and the trace file
+    //             to replay in `PMU_TEST_TRACE` mode.
+    PmuTestMode test_mode;
+    int         dfs_steps;
+    std::string trace_path;
+    uint64_t    random_seed;
+    uint64_t    random_start;
+    uint64_t    random_count;
+
+
+
+    // What is it: The number of clock cycles the last reset domain is released after the system reset (see `pll_reset.h`). The test
+    //             waits for them before it programs any PLL: a write to a PLL that is still held in reset would be lost.
+    unsigned    reset_release_cycles;
+
+    // What is it: The FRAC value the directed lock test programs with the solved dividers (`PLL_REG_FRAC_ADDR`). 0, the default, keeps
+    //             the PLLs integer-N and the register unwritten.
+    uint32_t    frac_val;
+
+
+
+    // What is it: Whether the end of the test sequence stops the kernel (`sc_stop()`), and whether the sequence has ended.
+    // Why is it used: The standalone simulator ends when the test does. A co-simulation host that embeds the model (`pllmodel.h`) owns
+    //               simulated time instead: it keeps stepping after the sequence is over, which `sc_stop()` would make impossible.
+    bool        stop_at_end;
+    bool        finished;
+
+
+
 
 // What is it: This is a C++ access specifier. The `public:` keyword means that all members declared after this point are
 //             accessible from outside the `pmu_tb` class. In SystemC, the constructor is always public so that the module can
@@ -175,6 +371,45 @@ private:
 public:
 
 
+
+    // What is it: Public setters used by `main.cpp` during elaboration to choose the scenario. Like `pll::set_base_address()`, they
+    //             exist because `SC_CTOR` only takes the instance name.
+    void set_test_mode(PmuTestMode mode) { test_mode = mode; }
+    void set_dfs_steps(int steps)        { dfs_steps = steps; }
+    void set_agent_steps(int steps)      { agent_steps = steps; }
+    void set_reset_release_cycles(unsigned cycles) { reset_release_cycles = cycles; }
+    void set_frac(uint32_t frac)                   { frac_val = frac; }
+    void set_trace_path(const std::string& path) { trace_path = path; }
+    void set_hist_out(const std::string& path)   { hist_out_path = path; }
+    void set_scoreboard(PllScoreboard* sb)       { scoreboard = sb; }
+    void set_domain_reset(pll_reset_ctrl* tree, unsigned domain, const std::vector<uint32_t>& domain_of) {
+        reset_tree = tree; reset_domain = domain; domain_of_pll = domain_of;
+    }
+    void set_random(uint64_t seed, uint64_t start, uint64_t count) {
+        random_seed = seed; random_start = start; random_count = count;
+    }
+
+    const std::vector<sc_time>& initial_lock_times() const { return initial_lock_time; }
+
+    // What is it: When the domain reset scenario asserted its domain's reset (`SC_ZERO_TIME` if it did not run).
+    const sc_time& domain_reset_start() const { return domain_reset_time; }
+
+    PmuTestMode test_mode_selected() const { return test_mode; }
+
+    void set_stop_at_end(bool stop) { stop_at_end = stop; }
+    bool test_finished() const      { return finished; }
+
+    // What is it: The latency histogram with the given name (see `report_histograms()`), or NULL if there is none.
+    const LatencyHistogram* histogram(const std::string& name) const;
+
+
+
+    // What is it: A switch for the per-transaction log lines (bus writes, individual interrupts, individual DFS steps).
+    // Why is it used: Replaying a long trace means millions of bus writes; printing each one would dominate the run time and bury the
+    //               summary. `static` because it is a property of the run, not of one testbench instance, like `pll::verbose`.
+    static bool verbose;
+
+
     //================================================================================================================================
     // SystemC Concept: The Constructor (`SC_CTOR`)
     //================================================================================================================================
@@ -188,13 +423,30 @@ public:
     //                         sets up the testbench so that it's ready to start executing its test sequence as soon as the simulation
     //                         begins.
 
-    SC_CTOR(pmu_tb) {
+    SC_CTOR(pmu_tb) : pll_irq("pll_irq"),
+                      hist_lock("lock_from_first_write"), hist_ctrl("lock_from_ctrl_write"),
+                      hist_relock("relock"), hist_bus("bus_write") {
 
 
 
         // This is a C++ `cout` statement that prints a message to the console. It's a simple and effective debug technique to confirm
-        // in the simulation log that the testbench instance was successfully created at the start of elaboration.
-        cout << "PMU Testbench module constructed." << endl;
+        // in the simulation log that the testbench instance was successfully created at the start of elaboration. Silent with
+        // `--quiet`, like the PLLs' own message.
+        if (verbose) {
+            cout << "PMU Testbench module constructed." << endl;
+        }
+
+        // The default scenario is the original directed lock test.
+        test_mode = PMU_TEST_LOCK;
+        dfs_steps = 10;
+        scoreboard = NULL;
+        random_seed = 1; random_start = 0; random_count = 0;
+        agents = NULL; agent_steps = 10; agent_relocks = 0; agent_failures = 0;
+        reset_release_cycles = 0;
+        reset_tree = NULL; reset_domain = 0;
+        frac_val = 0;
+        stop_at_end = true;
+        finished    = false;
 
 
 
@@ -0,0 +1,85 @@
+//
+// File: spsc_queue.h
+//
+// Project: C++/SystemC High-Level Model of a PLL Configuration
+//
+// Author: Kumar Vedang
+//
+// Description:
+// This header provides `SpscQueue`, a bounded, lock-free, single-producer / single-consumer ring buffer. It is the hand-off between the
+// SystemC kernel thread (which produces observed transactions) and the scoreboard's worker thread (which consumes and checks them).
+//
+// Why lock-free, and why SPSC: The producer is the simulation itself. A mutex on every transaction would put a system call (or at least
+// a contended atomic read-modify-write) in the middle of `bus_process`. With exactly one producer and one consumer, a ring buffer only
+// needs two indices, each written by one side and read by the other, so a push or pop is a couple of plain loads and stores with
+// acquire / release ordering. That restriction is easy to honour here: the SystemC kernel runs all processes on one OS thread.
+//
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+
+// What is it: The assumed size of a CPU cache line. The two indices are kept on separate lines so the producer and consumer cores do not
+//             keep stealing one line from each other ("false sharing").
+#define SPSC_CACHE_LINE 64
+
+
+
+template <typename T>
+class SpscQueue {
+public:
+
+    // 'capacity' is rounded up to a power of two, so that wrapping an index is a bit mask instead of a division.
+    explicit SpscQueue(size_t capacity) : head(0), tail(0) {
+        size_t n = 2;
+        while (n < capacity) n <<= 1;
+        slots.resize(n);
+        mask = n - 1;
+    }
+
+    // What is it: Producer side. Returns `false` if the queue is full; the caller decides whether to retry or drop.
+    bool try_push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);              // only the producer writes `tail`
+        if (t - head.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);                  // publishes the slot to the consumer
+        return true;
+    }
+
+    // What is it: Consumer side. Returns `false` if the queue is empty.
+    bool try_pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);              // only the consumer writes `head`
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);                  // hands the slot back to the producer
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    SpscQueue(const SpscQueue&);             // Not copyable: the indices are shared with another thread.
+    SpscQueue& operator=(const SpscQueue&);
+
+    // The indices grow forever and are masked on use; `size_t` wrap-around after 2^64 pushes is harmless for the subtraction above.
+    alignas(SPSC_CACHE_LINE) std::atomic<size_t> head;   // next slot to pop, written by the consumer
+    alignas(SPSC_CACHE_LINE) std::atomic<size_t> tail;   // next slot to fill, written by the producer
+    alignas(SPSC_CACHE_LINE) size_t              mask;
+    std::vector<T>                               slots;
+};
+
+
+#endif // SPSC_QUEUE_H